@@ -0,0 +1,44 @@
+// counts every global operator new call, for the allocation benchmarks in the *_use.cpp demos
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Replacement operator new/delete can't be inline, so these are plain definitions:
+// include this header from exactly ONE translation unit (each demo is a single .cpp).
+
+inline std::size_t g_allocations = 0;   // std::allocator, std::string, std::pmr::new_delete_resource(), ...
+
+void *operator new(std::size_t size) {
+    g_allocations++;
+    if(void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+// over-aligned types and std::pmr::new_delete_resource() go through the aligned overloads
+void *operator new(std::size_t size, std::align_val_t align) {
+    g_allocations++;
+    const std::size_t alignment = static_cast<std::size_t>(align);
+    if(void *p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
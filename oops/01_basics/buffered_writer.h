@@ -0,0 +1,116 @@
+// batched output: format into one reusable buffer with std::to_chars, one write() syscall per buffer
+
+#pragma once
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <system_error>
+
+// Formats with std::to_chars (no locale, no allocation) into one reusable buffer (64 KB by default);
+// the whole buffer goes out in ONE write() when it is full, on flush() and on destruction.
+// If the same fd is also written through std::cout / printf, flush those first (std::cout.flush())
+// or the outputs interleave out of order.
+
+enum class ExportFormat {
+    Tsv,   // tab separated, same text as display()
+    Csv,   // comma separated, RFC 4180 quoting for fields that need it
+};
+
+class BufferedWriter {
+
+public:
+    static constexpr std::size_t kDefaultCapacity = 64 * 1024;
+
+    explicit BufferedWriter(int fd = STDOUT_FILENO, std::size_t capacity = kDefaultCapacity)
+        : fd_(fd), capacity_(capacity < 64 ? 64 : capacity), buffer_(std::make_unique<char[]>(capacity_)) {}
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    ~BufferedWriter() {
+        try {
+            flush();
+        }
+        catch(...) {
+            // destructors must not throw; call flush() explicitly to see write errors
+        }
+    }
+
+    void put(char c) {
+        if(used_ == capacity_)
+            flush();
+        buffer_[used_++] = c;
+    }
+
+    void write(std::string_view text) {
+        while(!text.empty()) {
+            if(used_ == capacity_)
+                flush();
+            const std::size_t n = text.size() < capacity_ - used_ ? text.size() : capacity_ - used_;
+            text.copy(buffer_.get() + used_, n);
+            used_ += n;
+            text.remove_prefix(n);
+        }
+    }
+
+    template <std::integral T>
+    void write_int(T value) {
+        // digits10 rounds down: one more digit, plus the sign (40 for __int128, under the 64-byte minimum)
+        constexpr std::size_t kMaxDigits = std::numeric_limits<T>::digits10 + 2;
+        if(capacity_ - used_ < kMaxDigits)
+            flush();
+        const std::to_chars_result result = std::to_chars(buffer_.get() + used_, buffer_.get() + capacity_, value);
+        used_ = static_cast<std::size_t>(result.ptr - buffer_.get());
+    }
+
+    // a field for `format`: Tsv writes it as is, Csv quotes it when it contains , " or a newline
+    void write_field(std::string_view text, ExportFormat format) {
+        if(format == ExportFormat::Tsv || text.find_first_of(",\"\r\n") == std::string_view::npos) {
+            write(text);
+            return;
+        }
+        put('"');
+        for(char c : text) {
+            if(c == '"')
+                put('"');   // "" is an escaped quote
+            put(c);
+        }
+        put('"');
+    }
+
+    static char separator(ExportFormat format) {
+        return format == ExportFormat::Tsv ? '\t' : ',';
+    }
+
+    // hands everything buffered so far to the kernel
+    void flush() {
+        const char *p = buffer_.get();
+        std::size_t left = used_;
+        while(left > 0) {
+            const ssize_t written = ::write(fd_, p, left);
+            if(written < 0) {
+                if(errno == EINTR)
+                    continue;
+                const int error = errno;
+                used_ = 0;   // drop the batch rather than retrying it forever
+                throw std::system_error(error, std::generic_category(), "BufferedWriter::flush");
+            }
+            p += written;
+            left -= static_cast<std::size_t>(written);
+        }
+        used_ = 0;
+    }
+
+private:
+    int fd_;
+    std::size_t capacity_;
+    std::unique_ptr<char[]> buffer_;
+    std::size_t used_ = 0;
+};
@@ -0,0 +1,27 @@
+// wall-clock timing of code that writes to stdout, with the output discarded
+
+#pragma once
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <iostream>
+
+#include "timing.h"
+
+// runs f with file descriptor 1 (stdout) pointing at /dev/null
+template <typename F>
+double time_to_dev_null_ms(F f) {
+    std::cout.flush();
+    const int saved_stdout = ::dup(STDOUT_FILENO);
+    const int dev_null = ::open("/dev/null", O_WRONLY);
+    ::dup2(dev_null, STDOUT_FILENO);
+    const double ms = time_ms([&] {
+        f();
+        std::cout.flush();
+    });
+    ::dup2(saved_stdout, STDOUT_FILENO);
+    ::close(dev_null);
+    ::close(saved_stdout);
+    return ms;
+}
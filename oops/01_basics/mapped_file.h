@@ -0,0 +1,103 @@
+// read-only memory-mapped file (POSIX mmap), RAII
+// the file's bytes appear directly in our address space; the OS pages them in on first touch
+
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+// read() vs mmap():
+//   read():  kernel copies file bytes into OUR buffer (a copy per byte, plus the buffer itself)
+//   mmap():  the page cache pages ARE our buffer; nothing is copied, nothing is parsed up front.
+//            opening a 10 GB file is O(1); each 4 KB page costs one page fault the first time it's read.
+//
+// The mapping stays valid after the file descriptor is closed, so we close it right away.
+
+class MappedFile {
+
+public:
+    MappedFile() = default;
+
+    explicit MappedFile(const std::string &path) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if(fd < 0)
+            throw std::system_error(errno, std::generic_category(), "open " + path);
+
+        struct stat st{};
+        if(::fstat(fd, &st) != 0) {
+            const int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "fstat " + path);
+        }
+
+        size_ = static_cast<std::size_t>(st.st_size);
+        if(size_ > 0) {   // mmap of length 0 is an error; an empty file is just an empty view
+            void *p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(p == MAP_FAILED) {
+                const int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "mmap " + path);
+            }
+            data_ = static_cast<const char *>(p);
+        }
+        ::close(fd);
+    }
+
+    // owns the mapping -> move-only (like std::unique_ptr)
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile &&other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+    MappedFile& operator=(MappedFile &&other) noexcept {
+        if(this != &other) {
+            unmap();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    ~MappedFile() {
+        unmap();
+    }
+
+    const char *data() const {
+        return data_;
+    }
+
+    std::size_t size() const {
+        return size_;
+    }
+
+    std::string_view view() const {
+        return std::string_view(data_, size_);
+    }
+
+    // hint: we'll read front to back -> kernel reads ahead more aggressively
+    void advise_sequential() const {
+        if(data_)
+            ::madvise(const_cast<char *>(data_), size_, MADV_SEQUENTIAL);
+    }
+
+private:
+    void unmap() {
+        if(data_)
+            ::munmap(const_cast<char *>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    const char *data_ = nullptr;
+    std::size_t size_ = 0;
+};
@@ -0,0 +1,175 @@
+// hash index: roll number -> row index, O(1) lookup
+// open addressing, linear probing, flat array of 8-byte slots
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "student_table.h"
+
+// std::unordered_map is one heap node per entry: a lookup is bucket -> node -> (maybe) next node.
+// Here every entry is an 8-byte slot in one flat array, 8 slots per cache line:
+//   slots_ : [ roll|index ][ roll|index ][ empty ][ roll|index ] ...
+//   home slot = hash(roll); on a collision, the next slot (linear probing)
+// Values are INDICES into the roster (StudentTable rows, std::vector<Student> positions...), not pointers,
+// so they stay right when the roster reallocates; only moving a row (e.g. swap-and-pop erase) needs
+// insert(roll, new_index). erase() shifts the following entries back instead of leaving tombstones.
+
+class RollIndex {
+
+public:
+    static constexpr std::uint32_t kEmpty = UINT32_MAX;   // index value marking a free slot
+    static constexpr std::size_t kMinCapacity = 16;
+
+    RollIndex() = default;
+
+    explicit RollIndex(std::size_t expected_entries) {
+        reserve(expected_entries);
+    }
+
+    // bulk build from the roll column of a table: row i -> index i
+    static RollIndex build(const StudentTable &table) {
+        RollIndex index(table.size());
+        for(std::size_t i = 0; i < table.size(); i++)
+            index.insert(table.roll(i), i);
+        return index;
+    }
+
+    // bulk build from any range of Student-like rows: position i -> index i
+    template <typename Range>
+    static RollIndex build(const Range &rows) {
+        RollIndex index(std::size(rows));
+        std::size_t i = 0;
+        for(const auto &row : rows)
+            index.insert(row.get_roll(), i++);
+        return index;
+    }
+
+    std::size_t size() const {
+        return size_;
+    }
+
+    std::size_t capacity() const {
+        return slots_.size();
+    }
+
+    // makes room for `entries` without rehashing (max load factor 3/4)
+    void reserve(std::size_t entries) {
+        std::size_t capacity = kMinCapacity;
+        while(capacity * 3 / 4 < entries)
+            capacity *= 2;
+        if(capacity > slots_.size())
+            rehash(capacity);
+    }
+
+    // adds roll -> index, or updates the index if roll is already present
+    // returns true if roll was new
+    bool insert(int roll, std::size_t index) {
+        if(index >= kEmpty)
+            throw std::length_error("RollIndex: row index does not fit in 32 bits");
+        if((size_ + 1) * 4 > slots_.size() * 3)
+            rehash(slots_.empty() ? kMinCapacity : slots_.size() * 2);
+
+        for(std::size_t i = home(roll);; i = (i + 1) & mask_) {
+            Slot &slot = slots_[i];
+            if(slot.index == kEmpty) {
+                slot = Slot{roll, static_cast<std::uint32_t>(index)};
+                size_++;
+                return true;
+            }
+            if(slot.roll == roll) {
+                slot.index = static_cast<std::uint32_t>(index);
+                return false;
+            }
+        }
+    }
+
+    std::optional<std::size_t> find(int roll) const {
+        if(slots_.empty())
+            return std::nullopt;
+        for(std::size_t i = home(roll);; i = (i + 1) & mask_) {
+            const Slot &slot = slots_[i];
+            if(slot.index == kEmpty)
+                return std::nullopt;   // probing reached a gap: roll can't be further on
+            if(slot.roll == roll)
+                return slot.index;
+        }
+    }
+
+    bool contains(int roll) const {
+        return find(roll).has_value();
+    }
+
+    // returns true if roll was present
+    bool erase(int roll) {
+        if(slots_.empty())
+            return false;
+        std::size_t hole = home(roll);
+        while(true) {
+            if(slots_[hole].index == kEmpty)
+                return false;
+            if(slots_[hole].roll == roll)
+                break;
+            hole = (hole + 1) & mask_;
+        }
+
+        // backward shift: pull later entries of the same probe run into the hole,
+        // so no lookup ever meets a gap before reaching its key
+        for(std::size_t next = (hole + 1) & mask_; slots_[next].index != kEmpty; next = (next + 1) & mask_) {
+            const std::size_t next_home = home(slots_[next].roll);
+            // can the entry at `next` legally sit at `hole`? only if its home is not in (hole, next]
+            const bool home_in_between = hole <= next ? (hole < next_home && next_home <= next)
+                                                      : (hole < next_home || next_home <= next);
+            if(!home_in_between) {
+                slots_[hole] = slots_[next];
+                hole = next;
+            }
+        }
+        slots_[hole].index = kEmpty;
+        size_--;
+        return true;
+    }
+
+    void clear() {
+        for(Slot &slot : slots_)
+            slot.index = kEmpty;
+        size_ = 0;
+    }
+
+private:
+    struct Slot {
+        int roll;
+        std::uint32_t index;   // kEmpty = free slot
+    };
+    static_assert(sizeof(Slot) == 8, "8 slots per 64-byte cache line");
+
+    // Fibonacci hashing: multiply by 2^64 / golden ratio, keep the TOP bits.
+    // Consecutive rolls (the common case) land far apart, and it's one multiply + shift.
+    std::size_t home(int roll) const {
+        const std::uint64_t key = static_cast<std::uint32_t>(roll);
+        return static_cast<std::size_t>((key * 11400714819323198485ull) >> shift_);
+    }
+
+    void rehash(std::size_t capacity) {   // capacity: power of two
+        std::vector<Slot> old = std::move(slots_);
+        slots_.assign(capacity, Slot{0, kEmpty});
+        mask_ = capacity - 1;
+        shift_ = 64;
+        for(std::size_t c = capacity; c > 1; c >>= 1)
+            shift_--;
+        size_ = 0;
+        for(const Slot &slot : old) {
+            if(slot.index != kEmpty)
+                insert(slot.roll, slot.index);
+        }
+    }
+
+    std::vector<Slot> slots_;
+    std::size_t size_ = 0;
+    std::size_t mask_ = 0;
+    unsigned shift_ = 64;
+};
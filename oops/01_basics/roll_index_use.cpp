@@ -0,0 +1,97 @@
+// build: g++ -std=c++20 -O2 roll_index_use.cpp
+// run:   ./a.out               (1M and 10M entries)
+//        ./a.out 100000000     (100M entries: ~1.6 GB of RAM for the table + index)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "roll_index.h"
+
+constexpr std::size_t kLookups = 1'000'000;
+
+// times every lookup on its own; steady_clock's own cost (measured the same way) is subtracted.
+// entries > 0: the lookups pick among the inserted rolls
+void lookup_latency(std::size_t entries) {
+    std::vector<int> rolls(entries);
+    std::mt19937 rng(42);
+    for(std::size_t i = 0; i < entries; i++)
+        rolls[i] = static_cast<int>(i * 2654435761u);   // distinct, scattered roll numbers
+
+    RollIndex index(entries);
+    for(std::size_t i = 0; i < entries; i++)
+        index.insert(rolls[i], i);
+
+    std::uniform_int_distribution<std::size_t> pick(0, entries - 1);
+    std::vector<double> ns(kLookups);
+    std::vector<double> clock_ns(kLookups);
+    std::size_t checksum = 0;
+
+    for(std::size_t i = 0; i < kLookups; i++) {
+        const int roll = rolls[pick(rng)];
+        const auto start = std::chrono::steady_clock::now();
+        checksum += *index.find(roll);
+        const auto stop = std::chrono::steady_clock::now();
+        ns[i] = std::chrono::duration<double, std::nano>(stop - start).count();
+    }
+    for(std::size_t i = 0; i < kLookups; i++) {
+        const auto start = std::chrono::steady_clock::now();
+        const auto stop = std::chrono::steady_clock::now();
+        clock_ns[i] = std::chrono::duration<double, std::nano>(stop - start).count();
+    }
+
+    auto percentile = [](std::vector<double> &v, double p) {
+        const std::size_t k = static_cast<std::size_t>(p * static_cast<double>(v.size() - 1));
+        std::nth_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(k), v.end());
+        return v[k];
+    };
+    const double overhead = percentile(clock_ns, 0.5);
+    std::cout <<entries <<" entries: p50 " <<percentile(ns, 0.5) - overhead
+              <<" ns, p99 " <<percentile(ns, 0.99) - overhead
+              <<" ns (index " <<index.capacity() * 8 / (1 << 20) <<" MB, checksum " <<checksum % 1000 <<")\n";
+}
+
+int main(int argc, char **argv) {
+    StudentTable table;
+    table.append(1001, "Alice", 20);
+    table.append(1002, "Bob", 45);
+    table.append(1003, "Carol", 22);
+
+    RollIndex index = RollIndex::build(table);
+    table.display(*index.find(1002));              // 1002	Bob	45
+    std::cout <<index.contains(1004) <<'\n';      // 0
+
+    // the table grows (and reallocates): indices are still valid
+    for(int roll = 2000; roll < 3000; roll++)
+        index.insert(roll, table.append(roll, "student_" + std::to_string(roll), 18));
+    table.display(*index.find(1003));              // 1003	Carol	22
+    table.display(*index.find(2500));              // 2500	student_2500	18
+
+    index.erase(1002);
+    std::cout <<index.contains(1002) <<' ' <<index.size() <<'\n';   // 0 1002
+
+
+    // ------------------------------------------------------------
+    // Benchmark: lookup latency, p50 / p99
+    // ------------------------------------------------------------
+    if(argc > 1) {
+        const std::size_t entries = std::strtoull(argv[1], nullptr, 10);
+        if(entries == 0) {   // nothing to look up (and "abc" parses as 0 too)
+            std::cerr <<"usage: " <<argv[0] <<" [entries], entries > 0\n";
+            return 1;
+        }
+        lookup_latency(entries);
+    }
+    else {
+        lookup_latency(1'000'000);
+        lookup_latency(10'000'000);
+    }
+    // one cache (usually DRAM) miss per lookup dominates: ~100 ns, growing slowly with size
+    // as TLB misses join in (StudentTable::find scans the whole column instead: O(n))
+
+    return 0;
+}
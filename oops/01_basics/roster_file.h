@@ -0,0 +1,230 @@
+// binary on-disk roster format + zero-copy memory-mapped reader
+// fixed-width columns, offset-indexed name blob, no parsing on load
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mapped_file.h"
+#include "student.h"
+#include "student_table.h"
+
+// File layout (native byte order, little-endian on x86-64 / ARM64):
+//
+//   offset 0       RosterHeader (24 bytes)
+//                    magic "RSTR" | version | count | names_bytes
+//   24             int32  rolls[count]
+//   24 + 4c        int32  ages[count]
+//   24 + 8c        uint64 name_offsets[count + 1]    (8-aligned: 24 + 8c is a multiple of 8)
+//   24 + 16c + 8   char   names[names_bytes]         row i's name is names[off[i], off[i+1])
+//
+// Same struct-of-arrays idea as StudentTable, written to disk as is.
+// Loading = mmap + validating the header and the name index: no parsing, no copies.
+// The columns are then read IN PLACE from the page cache: a scan over ages only
+// faults in the age pages (4 bytes per student), names are never touched unless asked for.
+//
+// Versus text (what display() prints): every load re-parses every digit and
+// re-allocates every name, so startup is O(file size) of CPU work.
+
+struct RosterHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t count;
+    std::uint64_t names_bytes;
+};
+static_assert(sizeof(RosterHeader) == 24, "header layout is part of the file format");
+
+constexpr char kRosterMagic[4] = {'R', 'S', 'T', 'R'};
+constexpr std::uint32_t kRosterVersion = 1;
+
+
+// A Student "view": the fields of one row, name pointing into the mapped file.
+// Nothing is copied; valid only while the RosterFile is alive.
+// Same getters and display() as Student, so most read-only code works on either.
+struct StudentView {
+    int roll;
+    std::string_view name;
+    int age;
+
+    int get_roll() const { return roll; }
+    std::string_view get_name() const { return name; }
+    int get_age() const { return age; }
+
+    void display() const {   // same output as Student::display()
+        std::cout <<roll <<'\t' <<name <<'\t' <<age <<'\n';
+    }
+
+    // materializes a real Student (the one place the name gets copied)
+    Student to_student() const {
+        return Student(roll, name, age);
+    }
+};
+
+
+namespace roster_detail {
+
+inline void write_bytes(std::ofstream &out, const void *data, std::size_t bytes) {
+    out.write(static_cast<const char *>(data), static_cast<std::streamsize>(bytes));
+}
+
+inline void write_header(std::ofstream &out, std::uint64_t count, std::uint64_t names_bytes) {
+    RosterHeader header{};
+    std::memcpy(header.magic, kRosterMagic, sizeof(header.magic));
+    header.version = kRosterVersion;
+    header.count = count;
+    header.names_bytes = names_bytes;
+    write_bytes(out, &header, sizeof(header));
+}
+
+inline std::ofstream open_for_write(const std::string &path) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if(!out)
+        throw std::runtime_error("cannot open roster file for writing: " + path);
+    return out;
+}
+
+inline void finish(std::ofstream &out, const std::string &path) {
+    out.flush();
+    if(!out)
+        throw std::runtime_error("error writing roster file: " + path);
+}
+
+}   // namespace roster_detail
+
+
+// StudentTable already stores the columns: each one is a single bulk write
+inline void write_roster(const std::string &path, const StudentTable &table) {
+    std::ofstream out = roster_detail::open_for_write(path);
+    const std::size_t count = table.size();
+
+    roster_detail::write_header(out, count, table.name_arena().size());
+    roster_detail::write_bytes(out, table.rolls().data(), count * sizeof(std::int32_t));
+    roster_detail::write_bytes(out, table.ages().data(), count * sizeof(std::int32_t));
+    const std::vector<std::uint64_t> offsets(table.name_offsets().begin(), table.name_offsets().end());
+    roster_detail::write_bytes(out, offsets.data(), offsets.size() * sizeof(std::uint64_t));
+    roster_detail::write_bytes(out, table.name_arena().data(), table.name_arena().size());
+
+    roster_detail::finish(out, path);
+}
+
+// any range of Student-like rows (Student, StudentView, ...): get_roll(), get_name(), get_age()
+template <typename Range>
+void write_roster(const std::string &path, const Range &students) {
+    std::vector<std::int32_t> rolls;
+    std::vector<std::int32_t> ages;
+    std::vector<std::uint64_t> offsets{0};
+    std::string names;
+    for(const auto &s : students) {
+        rolls.push_back(s.get_roll());
+        ages.push_back(s.get_age());
+        names.append(s.get_name());
+        offsets.push_back(names.size());
+    }
+
+    std::ofstream out = roster_detail::open_for_write(path);
+    roster_detail::write_header(out, rolls.size(), names.size());
+    roster_detail::write_bytes(out, rolls.data(), rolls.size() * sizeof(std::int32_t));
+    roster_detail::write_bytes(out, ages.data(), ages.size() * sizeof(std::int32_t));
+    roster_detail::write_bytes(out, offsets.data(), offsets.size() * sizeof(std::uint64_t));
+    roster_detail::write_bytes(out, names.data(), names.size());
+    roster_detail::finish(out, path);
+}
+
+
+class RosterFile {
+
+public:
+    explicit RosterFile(const std::string &path) : file_(path) {
+        if(file_.size() < sizeof(RosterHeader))
+            throw std::runtime_error("roster file too small: " + path);
+
+        RosterHeader header;
+        std::memcpy(&header, file_.data(), sizeof(header));   // memcpy: no alignment/aliasing assumptions
+        if(std::memcmp(header.magic, kRosterMagic, sizeof(header.magic)) != 0)
+            throw std::runtime_error("not a roster file: " + path);
+        if(header.version != kRosterVersion)
+            throw std::runtime_error("unsupported roster version " + std::to_string(header.version) + ": " + path);
+
+        // every row takes at least 16 bytes (roll, age, offset): a bigger count can't be real, and
+        // bounding it first keeps the column arithmetic below from wrapping around
+        count_ = header.count;
+        if(count_ > file_.size() / 16)
+            throw std::runtime_error("truncated or corrupt roster file: " + path);
+        const std::uint64_t rolls_at = sizeof(RosterHeader);
+        const std::uint64_t ages_at = rolls_at + count_ * sizeof(std::int32_t);
+        const std::uint64_t offsets_at = ages_at + count_ * sizeof(std::int32_t);
+        const std::uint64_t names_at = offsets_at + (count_ + 1) * sizeof(std::uint64_t);
+        if(names_at > file_.size() || header.names_bytes != file_.size() - names_at)
+            throw std::runtime_error("truncated or corrupt roster file: " + path);
+
+        // the mapping is page-aligned and every column offset is a multiple of its element size
+        rolls_ = reinterpret_cast<const std::int32_t *>(file_.data() + rolls_at);
+        ages_ = reinterpret_cast<const std::int32_t *>(file_.data() + ages_at);
+        offsets_ = reinterpret_cast<const std::uint64_t *>(file_.data() + offsets_at);
+        names_ = file_.data() + names_at;
+
+        // only the ends of the name index here, so opening stays O(1) however many students there are;
+        // name(i) checks its own pair of offsets when it is read
+        if(offsets_[0] != 0 || offsets_[count_] != header.names_bytes)
+            throw std::runtime_error("corrupt name index in roster file: " + path);
+    }
+
+    std::size_t size() const {
+        return count_;
+    }
+
+    int roll(std::size_t i) const {
+        return rolls_[i];
+    }
+
+    int age(std::size_t i) const {
+        return ages_[i];
+    }
+
+    // throws if row i's offsets are out of order or past the names (a damaged file)
+    std::string_view name(std::size_t i) const {
+        const std::uint64_t begin = offsets_[i];
+        const std::uint64_t end = offsets_[i + 1];
+        if(begin > end || end > offsets_[count_])
+            throw std::runtime_error("corrupt name index in roster file, row " + std::to_string(i));
+        return std::string_view(names_ + begin, end - begin);
+    }
+
+    StudentView operator[](std::size_t i) const {
+        return StudentView{roll(i), name(i), age(i)};
+    }
+
+    // whole columns, straight out of the mapping
+    std::span<const std::int32_t> rolls() const {
+        return {rolls_, count_};
+    }
+
+    std::span<const std::int32_t> ages() const {
+        return {ages_, count_};
+    }
+
+    // copies the roster into an in-memory StudentTable (when it has to be modified)
+    StudentTable to_table() const {
+        StudentTable table;
+        table.reserve(count_, offsets_[count_]);
+        for(std::size_t i = 0; i < count_; i++)
+            table.append(roll(i), name(i), age(i));
+        return table;
+    }
+
+private:
+    MappedFile file_;
+    std::size_t count_ = 0;
+    const std::int32_t *rolls_ = nullptr;
+    const std::int32_t *ages_ = nullptr;
+    const std::uint64_t *offsets_ = nullptr;
+    const char *names_ = nullptr;
+};
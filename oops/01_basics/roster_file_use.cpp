@@ -0,0 +1,101 @@
+// build: g++ -std=c++20 -O2 roster_file_use.cpp
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "roster_file.h"
+#include "timing.h"
+
+// 5M rows keeps the demo under a second or two; the format is the same at 50M
+constexpr std::size_t kRows = 5'000'000;
+
+int main() {
+    const std::filesystem::path dir = std::filesystem::temp_directory_path();
+    const std::string small_path = (dir / "roster_small.bin").string();
+    const std::string binary_path = (dir / "roster.bin").string();
+    const std::string text_path = (dir / "roster.tsv").string();
+
+    std::vector<Student> students;
+    students.emplace_back(1, "Alice", 20);
+    students.emplace_back(2, "Bob", 45);
+    write_roster(small_path, students);
+
+    {
+        RosterFile roster(small_path);
+        std::cout <<roster.size() <<'\n';        // 2
+        roster[1].display();                     // 2	Bob	45
+        Student alice = roster[0].to_student();  // the name is copied only here
+        alice.display();                         // 1	Alice	20
+    }
+
+    // a damaged name index is refused by name(i) when that row is read, not read out of bounds
+    {
+        std::fstream patch(small_path, std::ios::binary | std::ios::in | std::ios::out);
+        const std::uint64_t bad_offset = 1'000'000;   // off[1] past the end of the names (and > off[2])
+        patch.seekp(sizeof(RosterHeader) + 2 * 2 * sizeof(std::int32_t) + sizeof(std::uint64_t));
+        patch.write(reinterpret_cast<const char *>(&bad_offset), sizeof(bad_offset));
+    }
+    {
+        RosterFile roster(small_path);           // opens: the ends of the index are intact
+        std::cout <<roster.age(1) <<'\n';        // 45 -- the other columns still read fine
+        try {
+            roster.name(1);
+        }
+        catch(const std::runtime_error &e) {
+            std::cout <<"refused: " <<(std::string(e.what()).find("corrupt name index") != std::string::npos) <<'\n';   // refused: 1
+        }
+    }
+
+
+    // ------------------------------------------------------------
+    // Benchmark: "startup" = load the roster and count students older than 40
+    // text (display() format, parsed with >>)  vs  binary (mmap)
+    // ------------------------------------------------------------
+    {
+        StudentTable table;
+        table.reserve(kRows, kRows * 16);
+        for(std::size_t i = 0; i < kRows; i++)
+            table.append(static_cast<int>(i), "student_" + std::to_string(i), static_cast<int>(i * 7919 % 80));
+        write_roster(binary_path, table);
+
+        std::ofstream text(text_path);
+        for(std::size_t i = 0; i < table.size(); i++)
+            text <<table.roll(i) <<'\t' <<table.name(i) <<'\t' <<table.age(i) <<'\n';
+    }
+
+    std::size_t text_count = 0;
+    const double text_ms = time_ms([&] {
+        std::ifstream in(text_path);
+        StudentTable loaded;
+        int roll, age;
+        std::string name;
+        while(in >> roll >> name >> age)
+            loaded.append(roll, name, age);
+        text_count = loaded.count_age_greater(40);
+    });
+
+    std::size_t binary_count = 0;
+    double open_ms = 0;
+    const double binary_ms = time_ms([&] {
+        std::optional<RosterFile> roster;
+        open_ms = time_ms([&] { roster.emplace(binary_path); });   // mmap + header checks
+        for(int age : roster->ages())
+            binary_count += static_cast<std::size_t>(age > 40);
+    });
+
+    std::cout <<"rows: " <<kRows <<'\n';
+    std::cout <<"text   load + scan: " <<text_ms <<" ms (count " <<text_count <<")\n";
+    std::cout <<"binary open:        " <<open_ms <<" ms\n";
+    std::cout <<"binary open + scan: " <<binary_ms <<" ms (count " <<binary_count <<")\n";
+    // the binary open is O(1): mmap, the header, the two ends of the name index (~0.05-0.2 ms here);
+    // the scan only faults in the 20 MB age column (~5000 pages, ~4.7 ms in all), the names are never read
+
+    std::filesystem::remove(small_path);
+    std::filesystem::remove(binary_path);
+    std::filesystem::remove(text_path);
+    return 0;
+}
@@ -0,0 +1,64 @@
+// sharded (per-thread striped) counter
+// lock-free writes that don't fight over one cache line, aggregated on read
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// A plain static int incremented from several threads is a data race (increments get lost).
+// One std::atomic is correct, but every increment needs its cache line exclusively, so threads queue on it.
+// Here there are kShards atomics, each padded to its own cache line; a thread picks one once (thread_local)
+// and only touches that one:
+//   [ shard 0 | pad to 64 ] [ shard 1 | pad to 64 ] ... [ shard 63 | pad to 64 ]   = 4 KB
+// load() sums the shards. It is not a snapshot: increments racing with it may or may not be counted,
+// fine for a statistic like "how many students are alive right now".
+
+class ShardedCounter {
+
+public:
+    static constexpr std::size_t kCacheLineSize = 64;   // std::hardware_destructive_interference_size on x86-64
+    static constexpr std::size_t kShards = 64;          // threads beyond this share shards (still correct)
+
+    ShardedCounter() = default;
+    ShardedCounter(const ShardedCounter&) = delete;
+    ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+    void add(long long delta) {
+        // relaxed: we only need each increment to be atomic, not ordered w.r.t. other memory
+        shards_[shard_index()].value.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    void increment() {
+        add(1);
+    }
+
+    void decrement() {
+        add(-1);
+    }
+
+    // sum of all shards
+    // a single shard may be negative (object built on thread A, destroyed on thread B),
+    // only the total is meaningful
+    long long load() const {
+        long long total = 0;
+        for(const Shard &shard : shards_)
+            total += shard.value.load(std::memory_order_relaxed);
+        return total;
+    }
+
+private:
+    struct alignas(kCacheLineSize) Shard {
+        std::atomic<long long> value{0};
+    };
+    static_assert(sizeof(Shard) == kCacheLineSize, "one shard per cache line");
+
+    static std::size_t shard_index() {
+        // assigned round-robin the first time a thread touches any ShardedCounter
+        static std::atomic<std::size_t> next_index{0};
+        thread_local const std::size_t index = next_index.fetch_add(1, std::memory_order_relaxed) % kShards;
+        return index;
+    }
+
+    Shard shards_[kShards];
+};
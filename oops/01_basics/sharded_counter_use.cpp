@@ -0,0 +1,97 @@
+// build: g++ -std=c++20 -O2 -pthread sharded_counter_use.cpp
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "student.h"
+
+constexpr int kStudentsPerThread = 2'000'000;
+
+// baseline for the benchmark: the "obvious" fix, one shared atomic
+std::atomic<long long> g_single_atomic{0};
+
+// Student(int roll) and ~Student() as they'd be with that fix: same members, same work, only the counter differs
+class SingleAtomicStudent {
+
+private:
+    const int roll_;
+    std::string name_;
+    int age_;
+
+public:
+    explicit SingleAtomicStudent(int roll) : roll_(roll) {
+        g_single_atomic.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    SingleAtomicStudent(const SingleAtomicStudent&) = delete;
+    SingleAtomicStudent& operator=(const SingleAtomicStudent&) = delete;
+
+    ~SingleAtomicStudent() {
+        g_single_atomic.fetch_sub(1, std::memory_order_relaxed);
+    }
+};
+
+// runs `work` on `threads` threads at once, returns wall time in ms
+template <typename F>
+double run_parallel(unsigned threads, F work) {
+    std::vector<std::thread> pool;
+    const auto start = std::chrono::steady_clock::now();
+    for(unsigned t = 0; t < threads; t++)
+        pool.emplace_back(work, t);
+    for(std::thread &th : pool)
+        th.join();
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+int main() {
+    {
+        Student s1(1);
+        Student s2(s1);                 // copy constructor counts
+        Student s3(std::move(s2));      // move constructor counts, s2 still alive (moved-from)
+        std::cout <<Student::get_total_students() <<'\n';   // 3
+    }
+    std::cout <<Student::get_total_students() <<'\n';       // 0 -- destructors decrement
+
+
+    // ------------------------------------------------------------
+    // Benchmark: parallel Student construction, 1..N threads
+    // each thread builds and destroys kStudentsPerThread students
+    // ideal scaling: the time stays flat as threads (and total work) grow
+    // ------------------------------------------------------------
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout <<"threads\tsharded ms\tMstudents/s\tsingle-atomic ms\n";
+    // 1, 2, 4, ... doubling, and max_threads as the last row
+    for(unsigned threads = 1;; threads = std::min(threads * 2, max_threads)) {
+        const double sharded_ms = run_parallel(threads, [](unsigned t) {
+            for(int i = 0; i < kStudentsPerThread; i++) {
+                Student s(static_cast<int>(t) * kStudentsPerThread + i);
+            }
+        });
+        const double atomic_ms = run_parallel(threads, [](unsigned t) {
+            for(int i = 0; i < kStudentsPerThread; i++) {
+                SingleAtomicStudent s(static_cast<int>(t) * kStudentsPerThread + i);
+            }
+        });
+        const double total = static_cast<double>(threads) * kStudentsPerThread;
+        std::cout <<threads <<'\t' <<sharded_ms <<"\t\t" <<total / sharded_ms / 1000.0
+                  <<"\t\t" <<atomic_ms <<'\n';
+        if(threads == max_threads)
+            break;
+    }
+
+    std::cout <<"live students: " <<Student::get_total_students() <<'\n';   // 0
+    // Both columns build and destroy the same object (a Student, or its single-atomic twin), so the
+    // difference is the counter alone. Measured on a 1-core VM: 1 thread, ~30 ms each -- uncontended, a
+    // sharded increment costs what one atomic does.
+    // Typical on an 8-core machine: the sharded column stays ~flat (linear throughput),
+    // the single-atomic column grows with the thread count (cache-line ping-pong).
+
+    return 0;
+}
@@ -3,8 +3,14 @@
 // intitalisation list, constant functions
 // static members, static functions
 
+#pragma once
+
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <utility>
+
+#include "sharded_counter.h"
 
 class Student {
 
@@ -13,8 +19,12 @@ private:
     std::string name_;
     int age_;
     // int &age_reference_;
-    static int total_students_; // a static variable  // for a class, not objects 
+    // static int total_students_; // a static variable  // for a class, not objects 
     // correct way to call : std::cout <<Student::total_students <<'\n';
+    // a plain static int is a data race once Students are built on several threads,
+    // so the live count is kept in a sharded counter (see sharded_counter.h):
+    // each thread increments its own cache line, get_total_students() sums them
+    inline static ShardedCounter total_students_;
     static const int annswer_to_the_life_universe_and_everything_ = 42;
     // static const std::string str;   // NOT ok inline pre-C++17, needs out-of-class definition
 
@@ -51,10 +61,27 @@ public:
     // 4 inbuilt functions we get with all classes: 
     // constructors, copy-constructor, copy-assignment operator(=), destrucor
 
-    Student(Student&&) = default;  // move constructor // explicitly compiler-generated // good for documentation/clarity
+    // Student(Student&&) = default;  // move constructor // explicitly compiler-generated // good for documentation/clarity
+    // a moved-from Student is still destroyed later, so the move constructor
+    // has to count the new object too, otherwise the destructor's decrement goes negative
+    // noexcept lets std::vector move (instead of copy) Students when it grows
+    Student(Student &&s) noexcept : roll_(s.roll_), name_(std::move(s.name_)), age_(s.age_) {
+        total_students_.increment();
+    }
     Student& operator=(const Student&) = delete;    // deleting the impplicit copy-assignment operator without defining custom one
     Student& operator=(Student&&) = delete;       // Move assignment operator
 
+private:
+    struct InPlaceName {};   // tag: picks the forwarding constructor below, only emplace() can name it
+
+    template <typename... NameArgs>
+    Student(InPlaceName, int roll, int age, NameArgs&&... name_args)
+        : roll_(roll), name_(std::forward<NameArgs>(name_args)...), age_(age) {
+        total_students_.increment();
+    }
+
+public:
+
 
     // Initialisation list  
     // allows to initialise constant/reference variables 
@@ -63,24 +90,44 @@ public:
     // defining a constructor supresses the defaul one
     // Members initialize in the order declared in the class, NOT initializer list order.
     // Always write initializer list in the same order as declaration.
-    Student(int roll, std::string name, int age) : roll_(roll), name_(std::move(name)), age_(age) {// this->age_(age_reference) : // how to initialise reference variables using intialisation list
-        // just to show how, but generally do this in the initalisation list only, and dont repeat inside  :
-        this->name_ = name; // but generally do this in the initalisation list only, and noo need to do it again inside
-        this->set_name(name); // cons: adds logs / potentially slower; // pros: does validations if required
-        // b/w the above 2, usually ise the 1st for method internals, but choose according to the situation
-        total_students_++;
+    //
+    // name_ is written exactly ONCE, here, straight from the caller's characters.
+    // Don't repeat it in the body:
+    //     this->name_ = name;      // a second full copy of the same characters
+    //     this->set_name(name);    // and a third
+    // (the old version took `std::string name`, moved it into name_, then did both of the above
+    //  with the moved-from -- i.e. EMPTY -- `name`, wiping the name it had just stored)
+    // If validation is needed, validate `name` BEFORE the initializer list runs
+    // (e.g. a static helper used in the list), not by re-assigning afterwards.
+    Student(int roll, std::string_view name, int age) : roll_(roll), name_(name), age_(age) {// this->age_(age_reference) : // how to initialise reference variables using intialisation list
+        total_students_.increment();
     }
-    // Here cost of string initialisation: lvalue: 1 copy + 1move; rvalue : 1–2 moves
+    // Here cost of string initialisation: 1 copy, from the caller's buffer into name_, for lvalues and rvalues alike
+    // string literals, char *, std::string, std::string_view all convert to std::string_view for free
 
-    // Alterntive:
+    // Alterntives:
+    // Student(int roll, std::string name, int age) : roll_(roll), name_(std::move(name)), age_(age) {}
+    // cost of string initialisation: lvalue: 1 copy + 1move; rvalue : 1–2 moves
+    //
     // Student(int roll, const std::string& name, int age) : roll_(roll), name_(name), age_(age) {}
     // cost of string initialisation: lvalue: 1 copy; rvalue : 1 copy 
-    // the first constructor(the one using move)
     // U can pass rvalues to the string despite it taking reference because of its constness:
     // const reference extends lifetime and binds to rvalues
     // const T&  → binds to lvalues AND rvalues
     // T&  → binds to lvalues ONLY
-    // can pass string literals, char *, anything implicitly convertible to strings here in the string arg
+    // but a string literal / char * first becomes a temporary std::string: 1 extra allocation for long names
+
+    // In-place construction (perfect forwarding)
+    // name_args are forwarded untouched to std::string's constructor, so name_ is built directly
+    // from them -- nothing is copied that std::string wouldn't copy itself:
+    //     Student::emplace(1, 20, std::move(name));       // steals name's buffer
+    //     Student::emplace(2, 20, 8, 'x');                // name "xxxxxxxx", no source string at all
+    //     Student::emplace(3, 20, first, last);           // from an iterator range
+    // returns by value: guaranteed copy elision (C++17), the Student is built in the caller's storage
+    template <typename... NameArgs>
+    static Student emplace(int roll, int age, NameArgs&&... name_args) {
+        return Student(InPlaceName{}, roll, age, std::forward<NameArgs>(name_args)...);
+    }
 
 
     // Another paramaterised constructor
@@ -94,6 +141,7 @@ public:
 
         // with explicit:
         // Student s = 10;   // error
+        total_students_.increment();
     }
 
     // Copy constructor  
@@ -102,7 +150,7 @@ public:
     Student(Student const &s) : roll_(s.get_roll()), age_(s.get_age()) {
         this->name_ = s.name_; // Access control in C++ is per-class, not per-object:
         // Any member function of Student can access private members of any Student object.
-        total_students_++;
+        total_students_.increment();
     }
 
 
@@ -110,6 +158,7 @@ public:
     ~Student(){
         // destructors, constructors needn't and couldn't be declared const
         // ON ~Student() const : error: destructors may not be cv-qualified 
+        total_students_.decrement();   // count reflects live objects
     }
     // don't define constructors / destructors unless required, let compiler do most of the work
     // see rule of 0, 3, 5
@@ -152,8 +201,8 @@ public:
 
 
     //setters
-    void set_name(const std::string &name) {
-        this->name_ = name;
+    void set_name(std::string_view name) {   // string_view: literals and std::strings both bind without a temporary
+        this->name_ = name;                   // reuses name_'s buffer
     }
 
     void set_age(const int age) {
@@ -188,7 +237,7 @@ public:
     }
 
     static int get_total_students() { // static function  
-        return total_students_;
+        return static_cast<int>(total_students_.load());
         // how to use : std::cout <<Student::Total_students() <<'\n';
     }
 
@@ -0,0 +1,124 @@
+// arena (monotonic) allocation mode for bulk Student construction
+// std::pmr: memory resources, monotonic allocation
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+#include "student.h"
+
+// The problem:
+//   std::vector<Student> roster;  roster.emplace_back(i, long_name, age);   // x 1,000,000
+//   every name longer than the SSO buffer (15 chars in libstdc++) is its own malloc,
+//   and dropping the roster is a million free() calls.
+//
+// Monotonic (bump) allocation:
+//   std::pmr::monotonic_buffer_resource grabs big blocks from the heap and hands out
+//   memory by bumping a pointer. deallocate() is a no-op; everything is given back
+//   at once when the resource is released/destroyed.
+//
+//   [ block 1 (1 MB)                              ] [ block 2 (2 MB)  ...
+//   [ ArenaStudent[] | "name0" "name1" "name2" ...]
+//                     ^ bump pointer moves right, never back
+//
+// Opt-in: Student itself keeps its std::string name_ (and its API); the arena stores
+// ArenaStudent rows instead -- roll, age, and a view of the name's characters, copied
+// once into the arena. The caller still writes arena.emplace(1, "John", 20),
+// the same arguments as Student's constructor.
+//
+// Costs / caveats:
+//   - memory of erased students isn't reused until the whole arena is released
+//   - vector growth leaves the old buffer behind in the arena: reserve() up front when the size is known
+//   - rows don't count towards Student::get_total_students(); to_student() makes a real Student
+
+// One student whose name lives in a StudentArena; valid only while that arena is alive (and not cleared).
+// Same getters and display() as Student, so most read-only code works on either.
+struct ArenaStudent {
+    int roll;
+    std::string_view name;
+    int age;
+
+    int get_roll() const { return roll; }
+    std::string_view get_name() const { return name; }
+    int get_age() const { return age; }
+
+    void display() const {   // same output as Student::display()
+        std::cout <<roll <<'\t' <<name <<'\t' <<age <<'\n';
+    }
+
+    // materializes a real Student (the name is copied onto the heap)
+    Student to_student() const {
+        return Student(roll, name, age);
+    }
+};
+
+class StudentArena {
+
+public:
+    static constexpr std::size_t kDefaultBlockSize = std::size_t(1) << 20;   // first block: 1 MB, later blocks grow
+
+    explicit StudentArena(std::size_t expected_students = 0, std::size_t block_size = kDefaultBlockSize)
+        : resource_(block_size), students_(&resource_) {
+        if(expected_students > 0)
+            students_.reserve(expected_students);
+    }
+
+    // owns its resource, rows point into it -> neither copyable nor movable
+    StudentArena(const StudentArena&) = delete;
+    StudentArena& operator=(const StudentArena&) = delete;
+
+    // same arguments as Student(int roll, std::string_view name, int age); the name is copied into the arena
+    ArenaStudent &emplace(int roll, std::string_view name, int age) {
+        return students_.emplace_back(ArenaStudent{roll, store(name), age});
+    }
+
+    void reserve(std::size_t students) {
+        students_.reserve(students);
+    }
+
+    std::size_t size() const {
+        return students_.size();
+    }
+
+    const ArenaStudent &operator[](std::size_t i) const {
+        return students_[i];
+    }
+
+    ArenaStudent &operator[](std::size_t i) {
+        return students_[i];
+    }
+
+    auto begin() const { return students_.begin(); }
+    auto end() const { return students_.end(); }
+
+    std::pmr::memory_resource *resource() {
+        return &resource_;
+    }
+
+    // drops every row and gives all blocks back to the heap in one shot
+    void clear() {
+        {
+            std::pmr::vector<ArenaStudent> dropped(&resource_);
+            students_.swap(dropped);
+        }
+        resource_.release();
+    }
+
+private:
+    std::string_view store(std::string_view name) {
+        if(name.empty())
+            return {};
+        char *chars = static_cast<char *>(resource_.allocate(name.size(), 1));   // alignment 1: names packed back to back
+        std::memcpy(chars, name.data(), name.size());
+        return std::string_view(chars, name.size());
+    }
+
+    // declaration order matters: resource_ must outlive students_ (members are destroyed in reverse order)
+    std::pmr::monotonic_buffer_resource resource_;
+    std::pmr::vector<ArenaStudent> students_;
+};
@@ -0,0 +1,88 @@
+// build: g++ -std=c++20 -O2 student_construction_use.cpp
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "allocation_counter.h"
+#include "student.h"
+
+constexpr int kConstructions = 1'000'000;
+
+// the constructor as it used to be, kept here only as the benchmark baseline
+struct LegacyStudent {
+    const int roll_;
+    std::string name_;
+    int age_;
+
+    LegacyStudent(int roll, std::string name, int age) : roll_(roll), name_(std::move(name)), age_(age) {
+        this->name_ = name;     // name was moved from: assigns ""
+        this->set_name(name);   // and again
+    }
+
+    void set_name(const std::string &name) {
+        this->name_ = name;
+    }
+};
+
+template <typename F>
+void report(const char *label, F construct) {
+    const std::size_t before = g_allocations;
+    const auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < kConstructions; i++)
+        construct(i);
+    const auto stop = std::chrono::steady_clock::now();
+    std::cout <<label <<": "
+              <<static_cast<double>(g_allocations - before) / kConstructions <<" allocations, "
+              <<std::chrono::duration<double, std::nano>(stop - start).count() / kConstructions <<" ns per construction\n";
+}
+
+int main() {
+    const std::string long_name = "a name much longer than the SSO buffer";
+    const std::string &expected = long_name;
+
+    // the name survives construction, whichever way it arrives
+    Student from_literal(1, "a name much longer than the SSO buffer", 20);
+    Student from_string(2, long_name, 21);
+    Student from_temporary(3, std::string(long_name), 22);
+    Student from_view(4, std::string_view(long_name).substr(0, 6), 23);
+    std::string owned_name(long_name);
+    const char *owned_buffer = owned_name.data();
+    Student moved_in = Student::emplace(5, 24, std::move(owned_name));
+    Student filled = Student::emplace(6, 25, 8, 'x');
+
+    std::cout <<(from_literal.get_name() == expected) <<'\n';     // 1
+    std::cout <<(from_string.get_name() == expected) <<'\n';      // 1
+    std::cout <<(from_temporary.get_name() == expected) <<'\n';   // 1
+    std::cout <<from_view.get_name() <<'\n';                        // a name
+    std::cout <<(moved_in.get_name().data() == owned_buffer) <<'\n'; // 1 -- same buffer, nothing copied
+    std::cout <<filled.get_name() <<'\n';                           // xxxxxxxx
+
+    LegacyStudent legacy(7, long_name, 26);
+    std::cout <<'"' <<legacy.name_ <<"\"\n";                        // "" -- the bug being fixed
+
+
+    // ------------------------------------------------------------
+    // Benchmark: allocations (= heap copies of the name) per construction
+    // ------------------------------------------------------------
+    report("legacy      (std::string by value + 2 body assignments)", [&](int i) {
+        LegacyStudent s(i, long_name, 20);
+    });
+    report("Student     (string_view, one write)                   ", [&](int i) {
+        Student s(i, long_name, 20);
+    });
+    report("Student     (string literal)                           ", [&](int i) {
+        Student s(i, "a name much longer than the SSO buffer", 20);
+    });
+    report("emplace     (moved std::string)                        ", [&](int i) {
+        std::string name(long_name);   // 1 allocation, the source itself
+        Student s = Student::emplace(i, 20, std::move(name));
+    });
+    // legacy:   1 allocation (the by-value parameter; name_ steals it), then 2 assignments that lose the name
+    // Student:  1 allocation (name_ itself, nothing else), 0 for names that fit in SSO
+    // emplace:  1 allocation, and it is the caller's source string -- Student moves it in, allocates nothing
+    // ns: Student also pays the live-count increment/decrement;
+    //     legacy looks cheap only because its two extra assignments copy an empty string
+
+    return 0;
+}
@@ -0,0 +1,34 @@
+// batched TSV / CSV export of Student rows through BufferedWriter
+
+#pragma once
+
+#include "buffered_writer.h"
+#include "student.h"
+#include "student_table.h"
+
+// TSV output is byte-for-byte what display() prints:   roll \t name \t age \n
+// CSV output is the same three fields:                  roll , name , age \n   (name quoted if needed)
+
+// one row
+inline void export_student(BufferedWriter &out, int roll, std::string_view name, int age, ExportFormat format) {
+    const char sep = BufferedWriter::separator(format);
+    out.write_int(roll);
+    out.put(sep);
+    out.write_field(name, format);
+    out.put(sep);
+    out.write_int(age);
+    out.put('\n');
+}
+
+// any range of Student-like rows: Student, StudentView (roster_file.h), ...
+template <typename Range>
+void export_students(BufferedWriter &out, const Range &students, ExportFormat format = ExportFormat::Tsv) {
+    for(const auto &s : students)
+        export_student(out, s.get_roll(), s.get_name(), s.get_age(), format);
+}
+
+// columnar table: reads the columns directly, no Student is materialized
+inline void export_students(BufferedWriter &out, const StudentTable &table, ExportFormat format = ExportFormat::Tsv) {
+    for(std::size_t i = 0; i < table.size(); i++)
+        export_student(out, table.roll(i), table.name(i), table.age(i), format);
+}
@@ -0,0 +1,63 @@
+// build: g++ -std=c++20 -O2 student_export_use.cpp
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "dev_null_timing.h"
+#include "student_export.h"
+
+constexpr std::size_t kRows = 2'000'000;
+
+int main() {
+    std::vector<Student> students;
+    students.emplace_back(1, "Alice", 20);
+    students.emplace_back(2, "Smith, \"Bob\"", 45);
+
+    for(const Student &s : students)
+        s.display();
+    // 1	Alice	20
+    // 2	Smith, "Bob"	45
+    std::cout.flush();   // std::cout and the writer share fd 1: keep them in order
+
+    {
+        BufferedWriter out;
+        export_students(out, students);                       // identical to the two display() lines
+        export_students(out, students, ExportFormat::Csv);
+        // 1,Alice,20
+        // 2,"Smith, ""Bob""",45
+    }
+
+
+    // ------------------------------------------------------------
+    // Benchmark: display() per Student vs batched export
+    // ------------------------------------------------------------
+    std::vector<Student> many;
+    StudentTable table;
+    many.reserve(kRows);
+    for(std::size_t i = 0; i < kRows; i++) {
+        const std::string name = "student_" + std::to_string(i);
+        many.emplace_back(static_cast<int>(i), name, static_cast<int>(i % 80));
+        table.append(static_cast<int>(i), name, static_cast<int>(i % 80));
+    }
+
+    const double display_ms = time_to_dev_null_ms([&] {
+        for(const Student &s : many)
+            s.display();
+    });
+    const double export_ms = time_to_dev_null_ms([&] {
+        BufferedWriter out;
+        export_students(out, many);
+    });
+    const double table_ms = time_to_dev_null_ms([&] {
+        BufferedWriter out;
+        export_students(out, table);
+    });
+
+    std::cout <<kRows <<" students\n";
+    std::cout <<"display() loop:          " <<display_ms <<" ms\n";
+    std::cout <<"export_students(vector): " <<export_ms <<" ms (" <<display_ms / export_ms <<"x)\n";
+    std::cout <<"export_students(table):  " <<table_ms <<" ms (" <<display_ms / table_ms <<"x)\n";
+
+    return 0;
+}
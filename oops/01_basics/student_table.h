@@ -0,0 +1,188 @@
+// struct-of-arrays (columnar) storage for Student records
+// contiguous columns, pooled string arena, vectorizable scans
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "student.h"
+
+// std::vector<Student> stores whole rows (sizeof(Student) == 48 with libstdc++),
+// but a scan over ages needs 4 bytes per row.
+// StudentTable stores columns:
+//   rolls_ : [ r0 | r1 | r2 | ... ]
+//   ages_  : [ a0 | a1 | a2 | ... ]
+//   names_ : "alicebobcarol..."            every name back to back
+//   name_offsets_ : [ 0 | 5 | 8 | 13 ... ] row i's name is names_[off[i], off[i+1])
+// The scans are branch-free counted loops, so the compiler vectorizes them.
+// row(i) materializes a Student, name(i) is a view into names_.
+
+class StudentTable {
+
+private:
+    std::vector<int> rolls_;
+    std::vector<int> ages_;
+    std::vector<std::uint32_t> name_offsets_{0};   // size() + 1 entries, first is always 0
+    std::string names_;                            // name arena: all names back to back
+
+public:
+    StudentTable() = default;
+
+    void reserve(std::size_t rows, std::size_t name_bytes = 0) {
+        rolls_.reserve(rows);
+        ages_.reserve(rows);
+        name_offsets_.reserve(rows + 1);
+        names_.reserve(name_bytes);
+    }
+
+    // appends one row, returns its index
+    // offsets are 32-bit (half the column of size_t): the name arena is capped at 4 GiB
+    std::size_t append(int roll, std::string_view name, int age) {
+        if(name.size() > std::numeric_limits<std::uint32_t>::max() - names_.size())
+            throw std::length_error("StudentTable: name arena exceeds 4 GiB");
+        rolls_.push_back(roll);
+        ages_.push_back(age);
+        names_.append(name);
+        name_offsets_.push_back(static_cast<std::uint32_t>(names_.size()));
+        return rolls_.size() - 1;
+    }
+
+    std::size_t append(const Student &s) {
+        return append(s.get_roll(), s.get_name(), s.get_age());
+    }
+
+    std::size_t size() const {
+        return rolls_.size();
+    }
+
+    bool empty() const {
+        return rolls_.empty();
+    }
+
+
+    // column access (row i)
+    int roll(std::size_t i) const {
+        return rolls_[i];
+    }
+
+    int age(std::size_t i) const {
+        return ages_[i];
+    }
+
+    std::string_view name(std::size_t i) const {
+        // view into the arena: no copy, but invalidated by the next append()
+        return std::string_view(names_).substr(name_offsets_[i], name_offsets_[i + 1] - name_offsets_[i]);
+    }
+
+    // whole columns, for callers that want to write their own scans
+    const std::vector<int> &rolls() const {
+        return rolls_;
+    }
+
+    const std::vector<int> &ages() const {
+        return ages_;
+    }
+
+    const std::string &name_arena() const {
+        return names_;
+    }
+
+    const std::vector<std::uint32_t> &name_offsets() const {
+        return name_offsets_;
+    }
+
+
+    // materializes row i as a Student (copies the name out of the arena)
+    Student row(std::size_t i) const {
+        Student s(roll(i));
+        s.set_name(name(i));
+        s.set_age(age(i));
+        return s;
+    }
+
+    void set_age(std::size_t i, int age) {
+        if(age<0)   // same validation as Student::set_age
+            return;
+        ages_[i] = age;
+    }
+
+
+    // lookup by roll: linear scan over the roll column only (4 bytes per row)
+    // for repeated lookups build a RollIndex (roll_index.h) once: O(1) per lookup
+    std::optional<std::size_t> find(int roll) const {
+        for(std::size_t i = 0; i < rolls_.size(); i++) {
+            if(rolls_[i] == roll)
+                return i;
+        }
+        return std::nullopt;
+    }
+
+
+    // Scans
+    // Written as plain counted loops with no early exit and no branches in the body:
+    // (ages_[i] > age) is 0 or 1, so the sum compiles to vector compare + subtract.
+
+    std::size_t count_age_greater(int age) const {
+        const int *ages = ages_.data();
+        const std::size_t n = ages_.size();
+        std::size_t count = 0;
+        for(std::size_t i = 0; i < n; i++)
+            count += static_cast<std::size_t>(ages[i] > age);
+        return count;
+    }
+
+    std::size_t count_age_between(int low, int high) const {   // inclusive range
+        const int *ages = ages_.data();
+        const std::size_t n = ages_.size();
+        std::size_t count = 0;
+        for(std::size_t i = 0; i < n; i++)
+            count += static_cast<std::size_t>((ages[i] >= low) & (ages[i] <= high));
+        return count;
+    }
+
+    long long sum_ages() const {
+        const int *ages = ages_.data();
+        const std::size_t n = ages_.size();
+        long long sum = 0;
+        for(std::size_t i = 0; i < n; i++)
+            sum += ages[i];
+        return sum;
+    }
+
+    double average_age() const {
+        return empty() ? 0.0 : static_cast<double>(sum_ages()) / static_cast<double>(size());
+    }
+
+    int max_age() const {   // 0 for an empty table
+        if(empty())
+            return 0;
+        int best = ages_[0];
+        for(int a : ages_)
+            best = a > best ? a : best;
+        return best;
+    }
+
+    // generic filter: indices of rows whose age satisfies pred
+    // pred is a template parameter (not std::function) so it can be inlined into the loop
+    template <typename Pred>
+    std::vector<std::size_t> filter_by_age(Pred pred) const {
+        std::vector<std::size_t> rows;
+        for(std::size_t i = 0; i < ages_.size(); i++) {
+            if(pred(ages_[i]))
+                rows.push_back(i);
+        }
+        return rows;
+    }
+
+    void display(std::size_t i) const {   // same format as Student::display()
+        std::cout <<roll(i) <<'\t' <<name(i) <<'\t' <<age(i) <<'\n';
+    }
+};
@@ -0,0 +1,69 @@
+// build: g++ -std=c++20 -O2 -march=native student_table_use.cpp
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "student_table.h"
+#include "timing.h"
+
+// rows used for the scan benchmark (10M rows needs ~1 GB as std::vector<Student>)
+constexpr std::size_t kRows = 10'000'000;
+constexpr int kAgeThreshold = 40;
+
+int main() {
+    StudentTable table;
+    table.append(1, "Alice", 20);
+    table.append(2, "Bob", 45);
+    Student carol(3);
+    carol.set_name("Carol");
+    carol.set_age(22);
+    table.append(carol);
+    table.set_age(2, 31);
+
+    table.display(0);               // 1	Alice	20
+    table.display(1);               // 2	Bob	45
+    std::cout <<table.count_age_greater(25) <<'\n';  // 2
+
+    if(auto row = table.find(2))
+        table.row(*row).display();  // 2	Bob	45
+
+
+    // ------------------------------------------------------------
+    // Benchmark: count where age > N, AoS vs SoA
+    // ------------------------------------------------------------
+    std::vector<Student> students;
+    students.reserve(kRows);
+    StudentTable big;
+    big.reserve(kRows, kRows * 24);
+
+    for(std::size_t i = 0; i < kRows; i++) {
+        const int roll = static_cast<int>(i);
+        const int age = static_cast<int>(i * 7919 % 80);
+        std::string name = "student_with_a_long_name_" + std::to_string(i);   // longer than SSO
+        big.append(roll, name, age);
+        students.emplace_back(roll);
+        students.back().set_name(name);
+        students.back().set_age(age);
+    }
+
+    std::size_t aos_count = 0;
+    std::size_t soa_count = 0;
+
+    const double aos_ms = time_ms([&] {
+        for(const Student &s : students)
+            aos_count += static_cast<std::size_t>(s.get_age() > kAgeThreshold);
+    });
+    const double soa_ms = time_ms([&] {
+        soa_count = big.count_age_greater(kAgeThreshold);
+    });
+
+    std::cout <<"rows: " <<kRows <<'\n';
+    std::cout <<"std::vector<Student> scan: " <<aos_ms <<" ms (count " <<aos_count <<")\n";
+    std::cout <<"StudentTable scan:         " <<soa_ms <<" ms (count " <<soa_count <<")\n";
+    std::cout <<"speedup: " <<aos_ms / soa_ms <<"x\n";
+    // typical -O2 -march=native result: ~4x
+    // the SoA scan streams a 40 MB age column, the AoS scan drags 480 MB of Student objects
+
+    return 0;
+}
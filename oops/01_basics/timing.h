@@ -0,0 +1,14 @@
+// wall-clock timing for the *_use.cpp benchmarks
+
+#pragma once
+
+#include <chrono>
+
+// runs f once, returns the elapsed wall time in milliseconds (steady_clock: never jumps)
+template <typename F>
+double time_ms(F f) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
@@ -0,0 +1,158 @@
+// arbitrary-precision fraction with Fraction's operator set (+, *, +=, ++, ==, <<)
+// BigInt numerator / denominator; values that fit in 64 bits take the same path as Fraction
+
+#pragma once
+
+#include <climits>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+
+#include "big_int.h"
+#include "fraction.h"
+#include "fraction_arithmetic.h"
+
+// Always canonical: lowest terms, denominator > 0 (so == is a field compare).
+//
+// Small path: while every numerator / denominator fits in int64 (BigInt's inline representation),
+// + and * go through fraction_arith -- the same checked 64/128-bit code as Fraction --
+// and only if the result doesn't fit in 64 bits do they switch to BigInt arithmetic.
+//
+// Big path: Knuth's cross-reduction (TAOCP vol. 2, 4.5.1), the gcds on the smallest operands possible:
+//   add:  g = gcd(b, d);  if g == 1 the result (a*d + c*b) / (b*d) is already in lowest terms
+//         else t = a*(d/g) + c*(b/g), g2 = gcd(t, g), result (t/g2) / ((b/g) * (d/g2))
+//   mul:  g1 = gcd(a, d), g2 = gcd(c, b), result (a/g1)*(c/g2) / ((b/g2)*(d/g1))
+
+class BigFraction {
+
+private:
+    BigInt numerator_;
+    BigInt denominator_{1};
+
+    struct Canonical {};   // tag: the arguments are already in lowest terms with a positive denominator
+
+    BigFraction(Canonical, BigInt numerator, BigInt denominator)
+        : numerator_(std::move(numerator)), denominator_(std::move(denominator)) {}
+
+    bool is_small() const {
+        return numerator_.is_small() && denominator_.is_small();
+    }
+
+    fraction_arith::Rational64 small() const {
+        return fraction_arith::Rational64{numerator_.to_int64(), denominator_.to_int64()};
+    }
+
+    static BigFraction from_small(fraction_arith::Rational64 r) {
+        return BigFraction(Canonical{}, BigInt(r.numerator), BigInt(r.denominator));
+    }
+
+    static BigFraction add_big(const BigFraction &x, const BigFraction &y) {
+        const BigInt g = gcd(x.denominator_, y.denominator_);
+        if(g == BigInt(1))
+            return BigFraction(Canonical{}, x.numerator_ * y.denominator_ + y.numerator_ * x.denominator_,
+                               x.denominator_ * y.denominator_);
+        const BigInt x_part = x.denominator_ / g;
+        const BigInt t = x.numerator_ * (y.denominator_ / g) + y.numerator_ * x_part;
+        if(t.is_zero())
+            return BigFraction();
+        const BigInt g2 = gcd(t, g);
+        return BigFraction(Canonical{}, t / g2, x_part * (y.denominator_ / g2));
+    }
+
+    static BigFraction mul_big(const BigFraction &x, const BigFraction &y) {
+        if(x.numerator_.is_zero() || y.numerator_.is_zero())
+            return BigFraction();
+        const BigInt g1 = gcd(x.numerator_, y.denominator_);
+        const BigInt g2 = gcd(y.numerator_, x.denominator_);
+        return BigFraction(Canonical{}, (x.numerator_ / g1) * (y.numerator_ / g2),
+                           (x.denominator_ / g2) * (y.denominator_ / g1));
+    }
+
+public:
+    BigFraction() = default;   // 0/1
+
+    // reduced on construction; throws std::domain_error for a zero denominator
+    BigFraction(BigInt numerator, BigInt denominator) {
+        if(denominator.is_zero())
+            throw std::domain_error("BigFraction: zero denominator");
+        const BigInt g = gcd(numerator, denominator);
+        if(!(g == BigInt(1))) {
+            numerator = numerator / g;
+            denominator = denominator / g;
+        }
+        if(denominator.is_negative()) {
+            numerator = -numerator;
+            denominator = -denominator;
+        }
+        numerator_ = std::move(numerator);
+        denominator_ = std::move(denominator);
+    }
+
+    // widening from Fraction never loses anything, so it is implicit
+    BigFraction(Fraction const &f) : BigFraction(BigInt(f.get_numerator()), BigInt(f.get_denominator())) {}
+
+    // getters
+    const BigInt &get_numerator() const {
+        return numerator_;
+    }
+
+    const BigInt &get_denominator() const {
+        return denominator_;
+    }
+
+    // back to Fraction, if it fits in int
+    std::optional<Fraction> to_fraction() const {
+        if(!is_small())
+            return std::nullopt;
+        const fraction_arith::Rational64 r = small();
+        if(r.numerator < INT_MIN || r.numerator > INT_MAX || r.denominator > INT_MAX)
+            return std::nullopt;
+        return Fraction(static_cast<int>(r.numerator), static_cast<int>(r.denominator));
+    }
+
+    // operators overloading (+, *, +=, ++, ==), same meaning as Fraction's -- but never overflow
+
+    BigFraction operator+ (BigFraction const &f2) const {
+        if(is_small() && f2.is_small()) {
+            if(const std::optional<fraction_arith::Rational64> r = fraction_arith::add(small(), f2.small()))
+                return from_small(*r);
+        }
+        return add_big(*this, f2);
+    }
+
+    BigFraction operator* (BigFraction const &f2) const {
+        if(is_small() && f2.is_small()) {
+            if(const std::optional<fraction_arith::Rational64> r = fraction_arith::mul(small(), f2.small()))
+                return from_small(*r);
+        }
+        return mul_big(*this, f2);
+    }
+
+    bool operator== (BigFraction const &f2) const {
+        // canonical: equal values have equal numerators and denominators
+        return numerator_ == f2.numerator_ && denominator_ == f2.denominator_;
+    }
+
+    // pre-increment: (n + d) / d is still in lowest terms
+    BigFraction& operator++() {
+        numerator_ += denominator_;
+        return *this;
+    }
+
+    BigFraction operator++(int) {
+        BigFraction original = *this;
+        ++(*this);
+        return original;
+    }
+
+    BigFraction& operator+=(BigFraction const &f2) {
+        *this = *this + f2;
+        return *this;
+    }
+
+    friend std::ostream& operator<<(std::ostream &os, BigFraction const &f) {
+        os <<f.numerator_ <<'/' <<f.denominator_;
+        return os;
+    }
+};
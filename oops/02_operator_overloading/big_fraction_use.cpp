@@ -0,0 +1,116 @@
+// build: g++ -std=c++20 -O2 big_fraction_use.cpp
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "../01_basics/timing.h"
+#include "big_fraction.h"
+
+BigInt random_big(std::size_t limbs, std::mt19937_64 &rng) {
+    const BigInt base = BigInt(INT64_MAX) + BigInt(1);   // 2^63
+    BigInt value = 0;
+    for(std::size_t i = 0; i < limbs; i++)
+        value = value * base + BigInt(static_cast<std::int64_t>(rng() >> 1));
+    return value;
+}
+
+// plain Euclid on BigInts: one long division per quotient
+BigInt euclid_gcd(BigInt a, BigInt b) {
+    while(!b.is_zero()) {
+        BigInt r = a % b;
+        a = std::move(b);
+        b = std::move(r);
+    }
+    return a;
+}
+
+int main() {
+    // H(n) = 1 + 1/2 + ... + 1/n: Fraction gives up at n = 25, BigFraction doesn't
+    BigFraction harmonic;
+    for(int k = 1; k <= 30; k++)
+        harmonic += Fraction(1, k);
+    std::cout <<"H(30) = " <<harmonic <<'\n';   // H(30) = 9304682830147/2329089562800
+
+    BigFraction h;
+    for(int k = 1; k <= 1000; k++)
+        h += Fraction(1, k);
+    std::cout <<"H(1000): " <<h.get_numerator().to_string().size() <<" digit numerator, "
+              <<h.get_denominator().to_string().size() <<" digit denominator\n";   // 434 and 433 digits
+
+    BigFraction f(BigInt::from_string("-340282366920938463463374607431768211456"), BigInt::from_string("-1208925819614629174706176"));
+    std::cout <<f <<'\n';                        // 281474976710656/1   (2^128 / 2^80)
+    std::cout <<++f <<'\n';                      // 281474976710657/1
+    std::cout <<(BigFraction(Fraction(1, 6)) + Fraction(1, 10) == Fraction(4, 15)) <<'\n';   // 1
+
+
+    // ------------------------------------------------------------
+    // Benchmark 1: small values, BigFraction vs Fraction (same fraction_arith 64-bit path)
+    // ------------------------------------------------------------
+    constexpr int kTerms = 2'000'000;
+    constexpr int kDenominators[] = {1, 2, 3, 4, 5, 6, 8, 10, 12};
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> numerator(-9, 9);
+    std::uniform_int_distribution<int> pick(0, 8);
+    std::vector<Fraction> terms;
+    for(int i = 0; i < kTerms; i++)
+        terms.emplace_back(numerator(rng), kDenominators[pick(rng)]);
+    const std::vector<BigFraction> big_terms(terms.begin(), terms.end());
+
+    Fraction total(0, 1);
+    const double fraction_ms = time_ms([&] {
+        for(const Fraction &t : terms)
+            total += t;
+    });
+    BigFraction big_total;
+    const double big_ms = time_ms([&] {
+        for(const BigFraction &t : big_terms)
+            big_total += t;
+    });
+    std::cout <<kTerms <<" small additions\n";
+    std::cout <<"Fraction +=:    " <<fraction_ms <<" ms, " <<total <<'\n';
+    std::cout <<"BigFraction +=: " <<big_ms <<" ms, " <<big_total <<", " <<big_ms / fraction_ms <<"x of Fraction\n";
+    // ~1.3x of Fraction: same fraction_arith path, plus the small checks and 2 BigInts per value, no allocation
+
+
+    // ------------------------------------------------------------
+    // Benchmark 2: gcd of two n-limb numbers, Euclid vs gcd() (Lehmer, half-gcd from 384 limbs)
+    // ------------------------------------------------------------
+    std::mt19937_64 big_rng(3);
+    std::cout <<"\nlimbs   Euclid(ms)   gcd(ms)   gcd growth per doubling\n";
+    double previous = 0;
+    for(std::size_t limbs = 16; limbs <= 8192; limbs *= 2) {
+        const int repeats = static_cast<int>(std::max<std::size_t>(8192 / limbs, 2));
+        std::vector<std::pair<BigInt, BigInt>> pairs;
+        for(int r = 0; r < repeats; r++)
+            pairs.emplace_back(random_big(limbs, big_rng), random_big(limbs, big_rng));
+
+        BigInt check_euclid = 0, check_gcd = 0;
+        const double gcd_ms = time_ms([&] {
+            for(const auto &[a, b] : pairs)
+                check_gcd += gcd(a, b);
+        }) / repeats;
+        std::cout <<limbs <<"\t";
+        if(limbs <= 512) {   // beyond that, Euclid takes seconds
+            const double euclid_ms = time_ms([&] {
+                for(const auto &[a, b] : pairs)
+                    check_euclid += euclid_gcd(a, b);
+            }) / repeats;
+            std::cout <<euclid_ms <<(check_euclid == check_gcd ? "" : " MISMATCH");
+        }
+        else {
+            std::cout <<"-";
+        }
+        std::cout <<"\t\t" <<gcd_ms <<"\t\t";
+        if(previous > 0)
+            std::cout <<gcd_ms / previous <<"x";
+        std::cout <<'\n';
+        previous = gcd_ms;
+    }
+    // Below 384 limbs gcd() is Lehmer, 8-17x faster than Euclid; per doubling it grows ~2.5x at first (O(n)
+    // overheads), heading to 4x: O(n^2), only with a much smaller constant. From there on it is half-gcd, and
+    // the growth comes back down to ~3x (O(n^1.585 log n)): at 8192 limbs ~0.3 s, where Lehmer alone took ~0.9 s.
+
+    return 0;
+}
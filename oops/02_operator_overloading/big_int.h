@@ -0,0 +1,770 @@
+// arbitrary-precision signed integer: 64-bit limbs, with an inline int64 fast path
+// Karatsuba multiply, Knuth's division (Algorithm D), Lehmer's gcd and half-gcd for very large values
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "fraction_arithmetic.h"
+#include "gcd_kernel.h"
+
+// Representation:
+//   small: the value fits in int64  -> stored in small_, limbs_ is EMPTY (an empty vector owns no memory)
+//   big:   anything else            -> sign in negative_, magnitude in limbs_ (little-endian, no leading zero limbs)
+// The representation is canonical: a value that fits in int64 is ALWAYS small.
+// So while values stay within 64 bits, BigInt is a 64-bit integer plus a branch:
+// no allocation, and overflow is detected with __builtin_*_overflow before falling back to limbs.
+//
+// Costs on the big path (n = number of limbs):
+//   + -      O(n)
+//   *        O(n^1.585) Karatsuba (schoolbook O(n*m) below kKaratsubaThreshold limbs)
+//   / %      O(n*m) Knuth's Algorithm D (TAOCP vol. 2, 4.3.1)
+//   gcd      O(n^2) Lehmer (TAOCP vol. 2, 4.5.2, Algorithm L): Euclid's quotient sequence is run on the
+//            leading 62 bits in machine words, and the bignums are only updated once per ~62 bits of
+//            progress (a 2x2 matrix of single-word cofactors), instead of one long division per quotient.
+//            Above kHalfGcdThreshold limbs, half-gcd: the same idea recursively, the matrix of the leading
+//            half found first and applied with Karatsuba -- O(n^1.585 log n).
+
+namespace big_int_detail {
+
+using Limbs = std::vector<std::uint64_t>;
+using uint128 = fraction_arith::uint128;
+
+inline void trim(Limbs &a) {
+    while(!a.empty() && a.back() == 0)
+        a.pop_back();
+}
+
+inline std::size_t bit_length(const Limbs &a) {
+    return a.empty() ? 0 : (a.size() - 1) * 64 + static_cast<std::size_t>(std::bit_width(a.back()));
+}
+
+inline int compare(const Limbs &a, const Limbs &b) {
+    if(a.size() != b.size())
+        return a.size() < b.size() ? -1 : 1;
+    for(std::size_t i = a.size(); i-- > 0;) {
+        if(a[i] != b[i])
+            return a[i] < b[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+inline Limbs add(const Limbs &a, const Limbs &b) {
+    const Limbs &longer = a.size() >= b.size() ? a : b;
+    const Limbs &shorter = a.size() >= b.size() ? b : a;
+    Limbs sum(longer.size() + 1);
+    std::uint64_t carry = 0;
+    for(std::size_t i = 0; i < longer.size(); i++) {
+        const uint128 s = static_cast<uint128>(longer[i]) + (i < shorter.size() ? shorter[i] : 0) + carry;
+        sum[i] = static_cast<std::uint64_t>(s);
+        carry = static_cast<std::uint64_t>(s >> 64);
+    }
+    sum[longer.size()] = carry;
+    trim(sum);
+    return sum;
+}
+
+// a - b, requires a >= b
+inline Limbs sub(const Limbs &a, const Limbs &b) {
+    Limbs difference(a.size());
+    std::uint64_t borrow = 0;
+    for(std::size_t i = 0; i < a.size(); i++) {
+        const std::uint64_t x = a[i];
+        const std::uint64_t y = i < b.size() ? b[i] : 0;
+        const std::uint64_t d1 = x - y;
+        const std::uint64_t d2 = d1 - borrow;
+        borrow = (x < y) | (d1 < borrow);
+        difference[i] = d2;
+    }
+    trim(difference);
+    return difference;
+}
+
+inline Limbs mul_limb(const Limbs &a, std::uint64_t m) {
+    if(a.empty() || m == 0)
+        return {};
+    Limbs product(a.size() + 1);
+    std::uint64_t carry = 0;
+    for(std::size_t i = 0; i < a.size(); i++) {
+        const uint128 p = static_cast<uint128>(a[i]) * m + carry;
+        product[i] = static_cast<std::uint64_t>(p);
+        carry = static_cast<std::uint64_t>(p >> 64);
+    }
+    product[a.size()] = carry;
+    trim(product);
+    return product;
+}
+
+inline Limbs mul_schoolbook(const Limbs &a, const Limbs &b) {
+    if(a.empty() || b.empty())
+        return {};
+    Limbs product(a.size() + b.size());
+    for(std::size_t i = 0; i < a.size(); i++) {
+        std::uint64_t carry = 0;
+        for(std::size_t j = 0; j < b.size(); j++) {
+            const uint128 p = static_cast<uint128>(a[i]) * b[j] + product[i + j] + carry;
+            product[i + j] = static_cast<std::uint64_t>(p);
+            carry = static_cast<std::uint64_t>(p >> 64);
+        }
+        product[i + b.size()] = carry;
+    }
+    trim(product);
+    return product;
+}
+
+// sum += addend * 2^(64 * offset), in place
+inline void add_shifted(Limbs &sum, const Limbs &addend, std::size_t offset) {
+    if(addend.empty())
+        return;
+    if(sum.size() < offset + addend.size())
+        sum.resize(offset + addend.size(), 0);
+    std::uint64_t carry = 0;
+    std::size_t i = 0;
+    for(; i < addend.size(); i++) {
+        const uint128 s = static_cast<uint128>(sum[offset + i]) + addend[i] + carry;
+        sum[offset + i] = static_cast<std::uint64_t>(s);
+        carry = static_cast<std::uint64_t>(s >> 64);
+    }
+    for(std::size_t j = offset + i; carry != 0; j++) {
+        if(j == sum.size())
+            sum.push_back(0);
+        sum[j] += carry;
+        carry = sum[j] == 0 ? 1 : 0;
+    }
+}
+
+// limbs [begin, end) of a, as a number
+inline Limbs slice(const Limbs &a, std::size_t begin, std::size_t end) {
+    begin = std::min(begin, a.size());
+    Limbs part(a.begin() + static_cast<std::ptrdiff_t>(begin), a.begin() + static_cast<std::ptrdiff_t>(std::min(end, a.size())));
+    trim(part);
+    return part;
+}
+
+constexpr std::size_t kKaratsubaThreshold = 48;   // limbs of the shorter operand; below it schoolbook wins
+
+// Karatsuba above kKaratsubaThreshold: with x = x1*B^m + x0, y = y1*B^m + y0 (B = 2^64)
+//   x*y = z2*B^2m + (z1 - z2 - z0)*B^m + z0,   z2 = x1*y1, z0 = x0*y0, z1 = (x1 + x0)*(y1 + y0)
+// three half-size products instead of four: O(n^1.585). A much longer x is cut into y-sized pieces first.
+inline Limbs mul(const Limbs &a, const Limbs &b) {
+    const Limbs &x = a.size() >= b.size() ? a : b;
+    const Limbs &y = a.size() >= b.size() ? b : a;
+    if(y.size() < kKaratsubaThreshold)
+        return mul_schoolbook(x, y);
+    if(x.size() >= 2 * y.size()) {
+        Limbs product;
+        for(std::size_t offset = 0; offset < x.size(); offset += y.size())
+            add_shifted(product, mul(slice(x, offset, offset + y.size()), y), offset);
+        trim(product);
+        return product;
+    }
+    const std::size_t m = (x.size() + 1) / 2;
+    const Limbs x0 = slice(x, 0, m), x1 = slice(x, m, x.size());
+    const Limbs y0 = slice(y, 0, m), y1 = slice(y, m, y.size());
+    const Limbs z0 = mul(x0, y0);
+    const Limbs z2 = mul(x1, y1);
+    const Limbs z1 = sub(sub(mul(add(x0, x1), add(y0, y1)), z0), z2);
+    Limbs product = z0;
+    add_shifted(product, z1, m);
+    add_shifted(product, z2, 2 * m);
+    trim(product);
+    return product;
+}
+
+// quotient of a / d, remainder returned through `remainder`
+inline Limbs divmod_limb(const Limbs &a, std::uint64_t d, std::uint64_t &remainder) {
+    Limbs quotient(a.size());
+    uint128 r = 0;
+    for(std::size_t i = a.size(); i-- > 0;) {
+        const uint128 current = (r << 64) | a[i];
+        quotient[i] = static_cast<std::uint64_t>(current / d);
+        r = current % d;
+    }
+    remainder = static_cast<std::uint64_t>(r);
+    trim(quotient);
+    return quotient;
+}
+
+inline Limbs shift_left(const Limbs &a, unsigned bits, std::size_t extra_limbs) {   // bits < 64
+    Limbs shifted(a.size() + extra_limbs, 0);
+    std::uint64_t carry = 0;
+    for(std::size_t i = 0; i < a.size(); i++) {
+        shifted[i] = (a[i] << bits) | carry;
+        carry = bits == 0 ? 0 : a[i] >> (64 - bits);
+    }
+    if(extra_limbs > 0)
+        shifted[a.size()] = carry;
+    return shifted;
+}
+
+// Knuth's Algorithm D: u = q*v + r, v.size() >= 2
+// (the loop structure follows Hacker's Delight divmnu64, with 64-bit limbs and 128-bit intermediates)
+inline void divmod(const Limbs &u, const Limbs &v, Limbs &quotient, Limbs &remainder) {
+    const std::size_t n = v.size();
+    if(compare(u, v) < 0) {
+        quotient.clear();
+        remainder = u;
+        return;
+    }
+    const std::size_t m = u.size() - n;
+    // normalize: top bit of the divisor set, so each quotient digit estimate is off by at most 2
+    const unsigned s = static_cast<unsigned>(std::countl_zero(v.back()));
+    const Limbs vn = shift_left(v, s, 0);
+    Limbs un = shift_left(u, s, 1);
+    quotient.assign(m + 1, 0);
+
+    const uint128 base = static_cast<uint128>(1) << 64;
+    for(std::size_t j = m + 1; j-- > 0;) {
+        const uint128 numerator = (static_cast<uint128>(un[j + n]) << 64) | un[j + n - 1];
+        uint128 qhat = numerator / vn[n - 1];
+        uint128 rhat = numerator % vn[n - 1];
+        while(qhat >= base || qhat * vn[n - 2] > ((rhat << 64) | un[j + n - 2])) {
+            qhat--;
+            rhat += vn[n - 1];
+            if(rhat >= base)
+                break;
+        }
+
+        // un[j .. j+n] -= qhat * vn
+        const std::uint64_t q = static_cast<std::uint64_t>(qhat);
+        std::uint64_t borrow = 0;
+        std::uint64_t carry = 0;
+        for(std::size_t i = 0; i < n; i++) {
+            const uint128 p = static_cast<uint128>(q) * vn[i] + carry;
+            carry = static_cast<std::uint64_t>(p >> 64);
+            const std::uint64_t low = static_cast<std::uint64_t>(p);
+            const std::uint64_t x = un[i + j];
+            const std::uint64_t d1 = x - low;
+            const std::uint64_t d2 = d1 - borrow;
+            borrow = (x < low) | (d1 < borrow);
+            un[i + j] = d2;
+        }
+        const std::uint64_t top = un[j + n];
+        const std::uint64_t d1 = top - carry;
+        un[j + n] = d1 - borrow;
+        const bool negative = (top < carry) | (d1 < borrow);
+
+        quotient[j] = q;
+        if(negative) {   // qhat was one too large (rare): add the divisor back
+            quotient[j]--;
+            std::uint64_t add_carry = 0;
+            for(std::size_t i = 0; i < n; i++) {
+                const uint128 sum = static_cast<uint128>(un[i + j]) + vn[i] + add_carry;
+                un[i + j] = static_cast<std::uint64_t>(sum);
+                add_carry = static_cast<std::uint64_t>(sum >> 64);
+            }
+            un[j + n] += add_carry;
+        }
+    }
+    trim(quotient);
+
+    // unnormalize the remainder
+    remainder.assign(n, 0);
+    for(std::size_t i = 0; i < n; i++)
+        remainder[i] = s == 0 ? un[i] : (un[i] >> s) | (un[i + 1] << (64 - s));
+    trim(remainder);
+}
+
+inline Limbs mod(const Limbs &u, const Limbs &v) {
+    if(v.size() == 1) {
+        std::uint64_t r;
+        divmod_limb(u, v[0], r);
+        return r == 0 ? Limbs{} : Limbs{r};
+    }
+    Limbs quotient, remainder;
+    divmod(u, v, quotient, remainder);
+    return remainder;
+}
+
+// 62 bits of a starting at bit `shift` (fewer if a is shorter)
+inline std::int64_t bits_at(const Limbs &a, std::size_t shift) {
+    const std::size_t limb = shift / 64;
+    const unsigned offset = static_cast<unsigned>(shift % 64);
+    if(limb >= a.size())
+        return 0;
+    std::uint64_t value = a[limb] >> offset;
+    if(offset != 0 && limb + 1 < a.size())
+        value |= a[limb + 1] << (64 - offset);
+    return static_cast<std::int64_t>(value & ((std::uint64_t{1} << 62) - 1));
+}
+
+// |x*a + y*b| where the true value is known to be >= 0 and x, y have opposite signs (or one is 0)
+inline Limbs combine(const Limbs &a, std::int64_t x, const Limbs &b, std::int64_t y) {
+    const Limbs xa = mul_limb(a, fraction_arith::magnitude(x));
+    const Limbs yb = mul_limb(b, fraction_arith::magnitude(y));
+    return (x > 0 || y < 0) ? sub(xa, yb) : sub(yb, xa);
+}
+
+// Lehmer's gcd (Knuth, Algorithm L)
+inline Limbs lehmer_gcd(Limbs a, Limbs b) {
+    if(compare(a, b) < 0)
+        std::swap(a, b);
+    while(b.size() > 1) {
+        // leading 62 bits of a, and the bits of b at the same position
+        const std::size_t shift = bit_length(a) - 62;
+        std::int64_t x = bits_at(a, shift);
+        std::int64_t y = bits_at(b, shift);
+
+        // run Euclid on (x, y) while the quotient is certain to be the same as for (a, b):
+        // (x + A) / (y + C) and (x + B) / (y + D) bracket the true quotient
+        std::int64_t A = 1, B = 0, C = 0, D = 1;
+        while(y + C > 0 && y + D > 0) {
+            const std::int64_t q = (x + A) / (y + C);
+            if(q != (x + B) / (y + D))
+                break;
+            std::int64_t t = A - q * C;
+            A = C;
+            C = t;
+            t = B - q * D;
+            B = D;
+            D = t;
+            t = x - q * y;
+            x = y;
+            y = t;
+        }
+
+        if(B == 0) {
+            // no certain quotient from the leading bits (a quotient too large for a word): one full division step
+            Limbs r = mod(a, b);
+            a = std::move(b);
+            b = std::move(r);
+        }
+        else {
+            // (a, b) <- (A*a + B*b, C*a + D*b): many Euclid steps in one O(n) pass
+            Limbs next_a = combine(a, A, b, B);
+            Limbs next_b = combine(a, C, b, D);
+            a = std::move(next_a);
+            b = std::move(next_b);
+        }
+    }
+    if(b.empty())
+        return a;
+    // b fits in one limb: one reduction of a, then the word-size binary gcd
+    std::uint64_t r;
+    divmod_limb(a, b[0], r);
+    return Limbs{gcd_kernel::binary_gcd(b[0], r)};
+}
+
+// |x - y|
+inline Limbs distance(const Limbs &x, const Limbs &y) {
+    return compare(x, y) >= 0 ? sub(x, y) : sub(y, x);
+}
+
+// Half-gcd (Schoenhage; the formulation of Moeller, "On Schoenhage's algorithm and subquadratic integer gcd
+// computation", 2008, which GMP uses). The reduction matrix M of n-limb numbers a, b:
+//   (a; b) = M (alpha; beta),  M's entries >= 0 and det M = +-1,  alpha, beta above B^s, s = n/2 + 1
+// so alpha and beta are about half the size of a and b, and gcd(alpha, beta) = gcd(a, b).
+// M is found from the leading half of a and b alone (recursively), and is then valid for all of a, b:
+// the low halves can't move alpha, beta by more than M's entries times B^(n/2), which is below B^s.
+// With Karatsuba multiplication for applying M, O(n^1.585 log n) instead of Lehmer's O(n^2).
+struct Matrix22 {
+    Limbs m00{1}, m01, m10, m11{1};
+
+    // this <- this * (n00 n01; n10 n11)
+    void multiply(const Limbs &n00, const Limbs &n01, const Limbs &n10, const Limbs &n11) {
+        Limbs r00 = add(mul(m00, n00), mul(m01, n10));
+        Limbs r01 = add(mul(m00, n01), mul(m01, n11));
+        Limbs r10 = add(mul(m10, n00), mul(m11, n10));
+        Limbs r11 = add(mul(m10, n01), mul(m11, n11));
+        m00 = std::move(r00);
+        m01 = std::move(r01);
+        m10 = std::move(r10);
+        m11 = std::move(r11);
+    }
+
+    // (a; b) <- M^-1 (a; b) = +-(m11*a - m01*b; m00*b - m10*a): both >= 0 for a valid reduction
+    void apply_inverse(Limbs &a, Limbs &b) const {
+        Limbs alpha = distance(mul(m11, a), mul(m01, b));
+        Limbs beta = distance(mul(m00, b), mul(m10, a));
+        a = std::move(alpha);
+        b = std::move(beta);
+    }
+};
+
+// one reduction step that keeps a and b above B^s, recorded in M; false if there is none.
+// Lehmer's inner loop on the leading 62 bits where it can be run; one division step otherwise.
+inline bool hgcd_step(Limbs &a, Limbs &b, std::size_t s, Matrix22 &M) {
+    const bool a_larger = compare(a, b) >= 0;
+    Limbs &big = a_larger ? a : b;
+    Limbs &small = a_larger ? b : a;
+    if(small.size() <= s)
+        return false;
+
+    // the new remainder is t*2^shift, give or take (its larger cofactor)*2^shift: a step is only taken
+    // while t - cofactor is at least 2^(64s - shift), i.e. the remainder certainly stays above B^s
+    const std::size_t shift = bit_length(big) - 62;
+    const std::size_t floor_bits = 64 * s > shift ? 64 * s - shift : 0;
+    if(floor_bits < 61) {
+        const std::int64_t floor = std::int64_t{1} << floor_bits;
+        std::int64_t x = bits_at(big, shift);
+        std::int64_t y = bits_at(small, shift);
+        std::int64_t A = 1, B = 0, C = 0, D = 1;
+        while(y + C > 0 && y + D > 0) {
+            const std::int64_t q = (x + A) / (y + C);
+            if(q != (x + B) / (y + D))
+                break;
+            const std::int64_t next_C = A - q * C;
+            const std::int64_t next_D = B - q * D;
+            const std::int64_t t = x - q * y;
+            if(t - std::max(next_C < 0 ? -next_C : next_C, next_D < 0 ? -next_D : next_D) < floor)
+                break;
+            A = C;
+            C = next_C;
+            B = D;
+            D = next_D;
+            x = y;
+            y = t;
+        }
+        if(B != 0) {
+            // (big, small) <- (A*big + B*small, C*big + D*small); its inverse is (|D| |B|; |C| |A|)
+            Limbs next_big = combine(big, A, small, B);
+            Limbs next_small = combine(big, C, small, D);
+            big = std::move(next_big);
+            small = std::move(next_small);
+            const auto limbs_of = [](std::int64_t v) { return v == 0 ? Limbs{} : Limbs{fraction_arith::magnitude(v)}; };
+            if(a_larger)
+                M.multiply(limbs_of(D), limbs_of(B), limbs_of(C), limbs_of(A));
+            else
+                M.multiply(limbs_of(A), limbs_of(C), limbs_of(B), limbs_of(D));   // the same with a and b swapped
+            return true;
+        }
+    }
+
+    // one division step: big -= q*small, with q one smaller if the remainder would drop to B^s or below
+    if(sub(big, small).size() <= s)
+        return false;
+    Limbs q, r;
+    divmod(big, small, q, r);
+    if(r.size() <= s) {
+        q = sub(q, Limbs{1});
+        r = add(r, small);
+    }
+    big = std::move(r);
+    if(a_larger)
+        M.multiply(Limbs{1}, q, Limbs{}, Limbs{1});
+    else
+        M.multiply(Limbs{1}, Limbs{}, q, Limbs{1});
+    return true;
+}
+
+inline bool hgcd(Limbs &a, Limbs &b, Matrix22 &M);
+
+// hgcd of the limbs from p up, with its matrix then applied to all of a and b (in M); false if no reduction
+inline bool hgcd_high(Limbs &a, Limbs &b, std::size_t p, Matrix22 &M) {
+    Limbs a_high = slice(a, p, a.size());
+    Limbs b_high = slice(b, p, b.size());
+    if(!hgcd(a_high, b_high, M))
+        return false;
+    M.apply_inverse(a, b);
+    return true;
+}
+
+constexpr std::size_t kHgcdThreshold = 128;   // limbs: below it, hgcd is steps only (Lehmer's loop, in effect)
+
+inline bool hgcd(Limbs &a, Limbs &b, Matrix22 &M) {
+    M = Matrix22{};
+    std::size_t n = std::max(a.size(), b.size());
+    const std::size_t s = n / 2 + 1;
+    if(n <= s)
+        return false;
+    bool reduced = false;
+    if(n >= kHgcdThreshold) {
+        // the leading half reduced (recursively) brings a, b down to ~3n/4 limbs ...
+        reduced = hgcd_high(a, b, n / 2, M);
+        while(std::max(a.size(), b.size()) > 3 * n / 4 + 1) {
+            if(!hgcd_step(a, b, s, M))
+                return reduced;
+            reduced = true;
+        }
+        // ... and the leading part of that, reduced again, to ~n/2
+        n = std::max(a.size(), b.size());
+        if(n > s + 2) {
+            Matrix22 M1;
+            if(hgcd_high(a, b, 2 * s - n + 1, M1)) {
+                M.multiply(M1.m00, M1.m01, M1.m10, M1.m11);
+                reduced = true;
+            }
+        }
+    }
+    while(hgcd_step(a, b, s, M))   // the last few limbs (or all of them, below the threshold)
+        reduced = true;
+    return reduced;
+}
+
+constexpr std::size_t kHalfGcdThreshold = 384;   // limbs: below it, Lehmer's gcd is faster
+
+// gcd: while the numbers are large, the leading third of their limbs reduced by hgcd (about n/6 limbs off
+// per round, GMP's choice), then Lehmer's
+inline Limbs gcd(Limbs a, Limbs b) {
+    if(compare(a, b) < 0)
+        std::swap(a, b);
+    while(b.size() >= kHalfGcdThreshold) {
+        Matrix22 M;
+        if(!hgcd_high(a, b, 2 * a.size() / 3, M)) {
+            // nothing to reduce in the leading limbs (b much shorter than a): one division step
+            Limbs r = mod(a, b);
+            a = std::move(b);
+            b = std::move(r);
+        }
+        if(compare(a, b) < 0)
+            std::swap(a, b);
+    }
+    return lehmer_gcd(std::move(a), std::move(b));
+}
+
+}   // namespace big_int_detail
+
+
+class BigInt {
+
+private:
+    using Limbs = big_int_detail::Limbs;
+
+    std::int64_t small_ = 0;   // the value, when limbs_ is empty
+    bool negative_ = false;    // big only
+    Limbs limbs_;              // big only: magnitude, little-endian
+
+    bool is_big() const {
+        return !limbs_.empty();
+    }
+
+    Limbs magnitude() const {
+        if(is_big())
+            return limbs_;
+        return small_ == 0 ? Limbs{} : Limbs{fraction_arith::magnitude(small_)};
+    }
+
+    // canonical: back to small whenever the value fits in int64
+    static BigInt from_magnitude(Limbs magnitude, bool negative) {
+        big_int_detail::trim(magnitude);
+        BigInt result;
+        if(magnitude.empty())
+            return result;
+        if(magnitude.size() == 1) {
+            const std::uint64_t m = magnitude[0];
+            if(m <= static_cast<std::uint64_t>(INT64_MAX)) {
+                result.small_ = negative ? -static_cast<std::int64_t>(m) : static_cast<std::int64_t>(m);
+                return result;
+            }
+            if(negative && m == static_cast<std::uint64_t>(INT64_MAX) + 1) {
+                result.small_ = INT64_MIN;
+                return result;
+            }
+        }
+        result.negative_ = negative;
+        result.limbs_ = std::move(magnitude);
+        return result;
+    }
+
+    static BigInt add_signed(const BigInt &a, bool a_negative, const BigInt &b, bool b_negative) {
+        const Limbs x = a.magnitude();
+        const Limbs y = b.magnitude();
+        if(a_negative == b_negative)
+            return from_magnitude(big_int_detail::add(x, y), a_negative);
+        const int order = big_int_detail::compare(x, y);
+        if(order >= 0)
+            return from_magnitude(big_int_detail::sub(x, y), a_negative);
+        return from_magnitude(big_int_detail::sub(y, x), b_negative);
+    }
+
+public:
+    BigInt() = default;
+
+    // implicit, like the built-in integer conversions: BigInt x = 5;
+    BigInt(std::int64_t value) : small_(value) {}
+
+    // decimal, optional leading '-'; throws std::invalid_argument
+    static BigInt from_string(std::string_view text) {
+        bool negative = false;
+        if(!text.empty() && (text[0] == '-' || text[0] == '+')) {
+            negative = text[0] == '-';
+            text.remove_prefix(1);
+        }
+        if(text.empty())
+            throw std::invalid_argument("BigInt: empty number");
+        Limbs magnitude;
+        // 19 digits at a time: 10^19 < 2^64
+        while(!text.empty()) {
+            const std::size_t chunk = text.size() % 19 == 0 ? 19 : text.size() % 19;
+            std::uint64_t value = 0;
+            std::uint64_t scale = 1;
+            for(char c : text.substr(0, chunk)) {
+                if(c < '0' || c > '9')
+                    throw std::invalid_argument("BigInt: invalid digit");
+                value = value * 10 + static_cast<std::uint64_t>(c - '0');
+                scale *= 10;
+            }
+            magnitude = big_int_detail::add(big_int_detail::mul_limb(magnitude, scale), value == 0 ? Limbs{} : Limbs{value});
+            text.remove_prefix(chunk);
+        }
+        return from_magnitude(std::move(magnitude), negative);
+    }
+
+    bool is_small() const {
+        return !is_big();
+    }
+
+    // precondition: is_small()
+    std::int64_t to_int64() const {
+        return small_;
+    }
+
+    bool is_zero() const {
+        return !is_big() && small_ == 0;
+    }
+
+    bool is_negative() const {
+        return is_big() ? negative_ : small_ < 0;
+    }
+
+    std::size_t bit_length() const {
+        return is_big() ? big_int_detail::bit_length(limbs_) : static_cast<std::size_t>(std::bit_width(fraction_arith::magnitude(small_)));
+    }
+
+    std::size_t limb_count() const {
+        return is_big() ? limbs_.size() : 1;
+    }
+
+    BigInt operator-() const {
+        if(!is_big() && small_ != INT64_MIN)
+            return BigInt(-small_);
+        return from_magnitude(magnitude(), !is_negative());
+    }
+
+    BigInt abs() const {
+        return is_negative() ? -*this : *this;
+    }
+
+    friend BigInt operator+(const BigInt &a, const BigInt &b) {
+        std::int64_t sum;
+        if(!a.is_big() && !b.is_big() && !__builtin_add_overflow(a.small_, b.small_, &sum))
+            return BigInt(sum);
+        return add_signed(a, a.is_negative(), b, b.is_negative());
+    }
+
+    friend BigInt operator-(const BigInt &a, const BigInt &b) {
+        std::int64_t difference;
+        if(!a.is_big() && !b.is_big() && !__builtin_sub_overflow(a.small_, b.small_, &difference))
+            return BigInt(difference);
+        return add_signed(a, a.is_negative(), b, !b.is_negative());
+    }
+
+    friend BigInt operator*(const BigInt &a, const BigInt &b) {
+        std::int64_t product;
+        if(!a.is_big() && !b.is_big() && !__builtin_mul_overflow(a.small_, b.small_, &product))
+            return BigInt(product);
+        return from_magnitude(big_int_detail::mul(a.magnitude(), b.magnitude()), a.is_negative() != b.is_negative());
+    }
+
+    // truncating division, like the built-in operators: the remainder has the sign of the dividend
+    // throws std::domain_error on division by zero
+    static void divmod(const BigInt &a, const BigInt &b, BigInt &quotient, BigInt &remainder) {
+        if(b.is_zero())
+            throw std::domain_error("BigInt: division by zero");
+        if(!a.is_big() && !b.is_big() && !(a.small_ == INT64_MIN && b.small_ == -1)) {
+            quotient = BigInt(a.small_ / b.small_);
+            remainder = BigInt(a.small_ % b.small_);
+            return;
+        }
+        const Limbs x = a.magnitude();
+        const Limbs y = b.magnitude();
+        Limbs q, r;
+        if(y.size() == 1) {
+            std::uint64_t r0;
+            q = big_int_detail::divmod_limb(x, y[0], r0);
+            r = r0 == 0 ? Limbs{} : Limbs{r0};
+        }
+        else {
+            big_int_detail::divmod(x, y, q, r);
+        }
+        quotient = from_magnitude(std::move(q), a.is_negative() != b.is_negative());
+        remainder = from_magnitude(std::move(r), a.is_negative());
+    }
+
+    friend BigInt operator/(const BigInt &a, const BigInt &b) {
+        BigInt quotient, remainder;
+        divmod(a, b, quotient, remainder);
+        return quotient;
+    }
+
+    friend BigInt operator%(const BigInt &a, const BigInt &b) {
+        BigInt quotient, remainder;
+        divmod(a, b, quotient, remainder);
+        return remainder;
+    }
+
+    BigInt& operator+=(const BigInt &b) {
+        return *this = *this + b;
+    }
+
+    BigInt& operator*=(const BigInt &b) {
+        return *this = *this * b;
+    }
+
+    // gcd(|a|, |b|) >= 0; binary gcd for small values, Lehmer / half-gcd for big ones
+    friend BigInt gcd(const BigInt &a, const BigInt &b) {
+        if(!a.is_big() && !b.is_big()) {
+            const std::uint64_t g = gcd_kernel::binary_gcd(fraction_arith::magnitude(a.small_), fraction_arith::magnitude(b.small_));
+            return from_magnitude(g == 0 ? Limbs{} : Limbs{g}, false);   // 2^63 (gcd of two INT64_MIN) doesn't fit int64
+        }
+        return from_magnitude(big_int_detail::gcd(a.magnitude(), b.magnitude()), false);
+    }
+
+    friend bool operator==(const BigInt &a, const BigInt &b) {
+        // canonical representation: a small value never equals a big one
+        if(a.is_big() != b.is_big())
+            return false;
+        if(!a.is_big())
+            return a.small_ == b.small_;
+        return a.negative_ == b.negative_ && a.limbs_ == b.limbs_;
+    }
+
+    friend std::strong_ordering operator<=>(const BigInt &a, const BigInt &b) {
+        if(!a.is_big() && !b.is_big())
+            return a.small_ <=> b.small_;
+        if(a.is_negative() != b.is_negative())
+            return a.is_negative() ? std::strong_ordering::less : std::strong_ordering::greater;
+        const int order = big_int_detail::compare(a.magnitude(), b.magnitude());
+        const int signed_order = a.is_negative() ? -order : order;
+        return signed_order < 0 ? std::strong_ordering::less
+             : signed_order > 0 ? std::strong_ordering::greater : std::strong_ordering::equal;
+    }
+
+    std::string to_string() const {
+        if(!is_big())
+            return std::to_string(small_);
+        // peel off 19 decimal digits at a time
+        constexpr std::uint64_t kChunk = 10'000'000'000'000'000'000ull;
+        std::vector<std::uint64_t> chunks;
+        Limbs rest = limbs_;
+        while(!rest.empty()) {
+            std::uint64_t r;
+            rest = big_int_detail::divmod_limb(rest, kChunk, r);
+            chunks.push_back(r);
+        }
+        std::string text = negative_ ? "-" : "";
+        text += std::to_string(chunks.back());
+        for(std::size_t i = chunks.size() - 1; i-- > 0;) {
+            const std::string digits = std::to_string(chunks[i]);
+            text.append(19 - digits.size(), '0');
+            text += digits;
+        }
+        return text;
+    }
+
+    friend std::ostream& operator<<(std::ostream &os, const BigInt &value) {
+        if(!value.is_big())
+            return os <<value.small_;
+        return os <<value.to_string();
+    }
+};
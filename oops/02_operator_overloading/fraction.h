@@ -1,50 +1,102 @@
 //operator overloading
-#include <iostream>
-#include <numeric>
-using namespace std;
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+#include "fraction_arithmetic.h"
+#include "gcd_kernel.h"
 
 class Fraction {
 private:
     int numerator;
     int denominator;
 
-    void simplify() {
-        int fraction_gcd = std::gcd(numerator, denominator);
-        numerator /= fraction_gcd;
-        denominator /= fraction_gcd;
+    // Arithmetic goes through fraction_arith (fraction_arithmetic.h):
+    // 64/128-bit intermediates (cross-reduced where they could overflow), result in lowest terms with a
+    // positive denominator: Fraction(1, -2) + Fraction(0, 1) prints -1/2 (the old operator+ printed 1/-2).
+    // to_int_fraction narrows that back to int, or reports that it doesn't fit.
+    constexpr fraction_arith::Rational64 wide() const {
+        return fraction_arith::Rational64{this->numerator, this->denominator};
+    }
+
+    static constexpr std::optional<Fraction> to_int_fraction(std::optional<fraction_arith::Rational64> r) {
+        if(!r || r->numerator < INT_MIN || r->numerator > INT_MAX || r->denominator > INT_MAX)
+            return std::nullopt;
+        return Fraction(static_cast<int>(r->numerator), static_cast<int>(r->denominator));
+    }
+
+    static constexpr Fraction value_or_throw(std::optional<Fraction> f, const char *operation) {
+        if(!f)
+            throw std::overflow_error(std::string("Fraction overflow in ") + operation);
+        return *f;
     }
 
 public:
-    Fraction(int numerator, int denominator) {
-        this->numerator = numerator;
-        this->denominator = denominator;
-        // simplify();
+    // everything below except simplify_all and operator<< is constexpr:
+    // Fractions can be built and combined in constant expressions (see static_fraction.h)
+    // member initializer list: the members are initialized directly, not default-initialized then assigned
+    constexpr Fraction(int numerator, int denominator) : numerator(numerator), denominator(denominator) {
+        // not reduced here: arithmetic results come back in lowest terms (fraction_arith),
+        // and simplify_all() reduces stored fractions in bulk (gcd_kernel.h)
+    }
+
+    // getters
+    constexpr int get_numerator() const {
+        return this->numerator;
+    }
+
+    constexpr int get_denominator() const {
+        return this->denominator;
+    }
+
+    // checked arithmetic: std::nullopt when the reduced result doesn't fit in int
+    constexpr std::optional<Fraction> checked_add(Fraction const &f2) const {
+        return to_int_fraction(fraction_arith::add(this->wide(), f2.wide()));
     }
 
-    // operators overloading (+, *, +=, ++, ==)
-    Fraction operator+ (Fraction const &f2) const {
-        int numerator = this->numerator * f2.denominator + f2.numerator * this->denominator;
-        int denominator = this->denominator * f2.denominator;
-        Fraction sum(numerator, denominator);
-        sum.simplify();
-        return sum;
+    constexpr std::optional<Fraction> checked_mul(Fraction const &f2) const {
+        return to_int_fraction(fraction_arith::mul(this->wide(), f2.wide()));
     }
 
-    Fraction operator* (Fraction const &f2) const {
-        Fraction product(this->numerator * f2.numerator, this->denominator * f2.denominator);
-        product.simplify();
-        return product;
+    // operators overloading (+, *, +=, ++, ==, <=>)
+    // the operators throw std::overflow_error where the result doesn't fit (instead of silently wrapping)
+    constexpr Fraction operator+ (Fraction const &f2) const {
+        return value_or_throw(checked_add(f2), "operator+");
     }
 
-    bool operator== (Fraction const &f2) const {
-        return (this->numerator*f2.denominator == f2.numerator*this->denominator);
+    constexpr Fraction operator* (Fraction const &f2) const {
+        return value_or_throw(checked_mul(f2), "operator*");
+    }
+
+    constexpr bool operator== (Fraction const &f2) const {
+        // cross-multiplied in 128 bits: can't overflow
+        return fraction_arith::equal(this->wide(), f2.wide());
+    }
+
+    // <, <=, >, >= (C++20 rewrites them in terms of <=>), compared by value like ==
+    constexpr std::weak_ordering operator<=> (Fraction const &f2) const {
+        // cross-multiplied in 128 bits: can't overflow
+        return fraction_arith::compare(this->wide(), f2.wide());
     }
 
     // pre-increment ++
     // We return Fraction& instead of Fraction 
     // this allows us to do something like ++(++f1); //f1 is a fraction //f1 += 2 here
-    Fraction& operator++() {
-        this->numerator += this->denominator;
+    constexpr Fraction& operator++() {
+        const long long incremented = static_cast<long long>(this->numerator) + this->denominator;
+        if(incremented < INT_MIN || incremented > INT_MAX)
+            throw std::overflow_error("Fraction overflow in operator++");
+        this->numerator = static_cast<int>(incremented);
         return *this;
     }
     // ofcourse, since this is our own class & definitions, we dont need to return by reference even for pre-fix increment
@@ -53,19 +105,26 @@ public:
 
     // post-increment ++  
     // represented by ++(int) by convention to differentiate from pre-increment ++
-    Fraction operator++(int) {
+    constexpr Fraction operator++(int) {
         Fraction original(this->numerator, this->denominator);
-        this->numerator += denominator;
+        ++(*this);
         return original;
     }
 
-    Fraction& operator+=(Fraction const & f2) {
-        this->numerator = this->numerator * f2.denominator + f2.numerator * this->denominator;
-        this->denominator = this->denominator * f2.denominator;
-        simplify();
+    // eager: the total is reduced after every step
+    // for long running totals see FractionAccumulator (fraction_accumulator.h), which defers the gcds
+    constexpr Fraction& operator+=(Fraction const & f2) {
+        const Fraction sum = value_or_throw(checked_add(f2), "operator+=");
+        this->numerator = sum.numerator;
+        this->denominator = sum.denominator;
         return *this;
     }
 
+    // reduces every fraction in the span, 8 at a time with AVX2 when available (gcd_kernel::reduce_batch)
+    // std::overflow_error if a lowest-terms form doesn't fit in int (INT_MIN/-1)
+    friend void simplify_all(std::span<Fraction> fractions);
+
+
 
     // Overloading <<
 
@@ -90,7 +149,43 @@ public:
     // friend is not a member function — just a free function with private access
 };
 
-std::ostream& operator<<(std::ostream &os, const Fraction &f) {
+// inline: defined in a header, so every .cpp including it gets the same single definition
+inline std::ostream& operator<<(std::ostream &os, const Fraction &f) {
     os <<f.numerator <<'/' <<f.denominator;
     return os;
 }
+
+// std::hash: equal values (1/2, 2/4, -1/-2) must hash the same, so hash the lowest-terms form
+// (in 64 bits: INT_MIN / -1 doesn't fit in an int)
+template <>
+struct std::hash<Fraction> {
+    std::size_t operator()(Fraction const &f) const noexcept {
+        const fraction_arith::Rational64 r = *fraction_arith::reduce(f.get_numerator(), f.get_denominator());
+        // splitmix64 finalizer over both halves: every input bit affects every output bit
+        std::uint64_t h = static_cast<std::uint64_t>(r.numerator) * 0x9E3779B97F4A7C15ull ^ static_cast<std::uint64_t>(r.denominator);
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+        h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+        return static_cast<std::size_t>(h ^ (h >> 31));
+    }
+};
+
+inline void simplify_all(std::span<Fraction> fractions) {
+    // Fraction stores numerator, denominator side by side; the kernel wants them in
+    // separate arrays (one SIMD register of numerators, one of denominators),
+    // so go through small stack blocks that stay in L1
+    constexpr std::size_t kBlock = 256;
+    std::int32_t numerators[kBlock];
+    std::int32_t denominators[kBlock];
+    for(std::size_t start = 0; start < fractions.size(); start += kBlock) {
+        const std::size_t n = std::min(kBlock, fractions.size() - start);
+        for(std::size_t i = 0; i < n; i++) {
+            numerators[i] = fractions[start + i].numerator;
+            denominators[i] = fractions[start + i].denominator;
+        }
+        gcd_kernel::reduce_batch(numerators, denominators, n);
+        for(std::size_t i = 0; i < n; i++) {
+            fractions[start + i].numerator = numerators[i];
+            fractions[start + i].denominator = denominators[i];
+        }
+    }
+}
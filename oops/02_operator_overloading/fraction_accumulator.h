@@ -0,0 +1,198 @@
+// running total of Fractions with lazy normalization
+// no gcd per +=, reduce only when the next step could overflow or canonical form is needed
+
+#pragma once
+
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+#include "fraction.h"
+#include "fraction_arithmetic.h"
+#include "gcd_kernel.h"
+
+// Fraction::operator+= is eager: every step is a full add in lowest terms,
+// i.e. a gcd and a couple of 64-bit divisions, so the total is always canonical.
+// A running total over millions of terms pays for that canonical form millions of times,
+// though nobody looks at it until the end.
+//
+// FractionAccumulator keeps the total UNREDUCED in 64 bits:
+//   n/d += a/b   ->   n*b + a*d  over  d*b           (3 multiplies, no gcd)
+//   n/d += a/d   ->   n + a      over  d             (same denominator: one add)
+// and tracks the bit width of |n| and d (an upper bound on their magnitude).
+// Before a step that could overflow 64 bits, the total is normalized (one gcd), which
+// usually brings it back to a few bits; only if the REDUCED total is still too wide does the
+// step go through the exact cross-reduced backend (fraction_arith::add, throws on real overflow).
+//
+// Canonical form is produced on demand: ==, <<, value() and normalize(),
+// so those give exactly what the eager Fraction total would.
+// (The one difference: the eager total throws as soon as a PARTIAL sum exceeds int,
+//  the accumulator only if a partial sum exceeds 64 bits or value() doesn't fit in int.)
+
+class FractionAccumulator {
+
+private:
+    // mutable: normalizing doesn't change the value, so the const ==, << and value() may do it
+    mutable std::int64_t numerator_ = 0;
+    mutable std::int64_t denominator_ = 1;
+    mutable unsigned numerator_bits_ = 0;     // bit width of |numerator_|
+    mutable unsigned denominator_bits_ = 1;   // bit width of |denominator_|
+    mutable bool pending_ = false;            // may not be in lowest terms / may have a negative denominator
+    mutable std::size_t normalizations_ = 0;
+
+    static unsigned bit_width(std::int64_t v) {
+        return static_cast<unsigned>(std::bit_width(fraction_arith::magnitude(v)));
+    }
+
+    void set(std::int64_t numerator, std::int64_t denominator) const {
+        numerator_ = numerator;
+        denominator_ = denominator;
+        numerator_bits_ = bit_width(numerator);
+        denominator_bits_ = bit_width(denominator);
+    }
+
+    // |n*b + a*d| < 2^63 and |d*b| < 2^63, from the bit widths alone
+    bool add_fits(unsigned a_bits, unsigned b_bits) const {
+        return numerator_bits_ + b_bits <= 61 && a_bits + denominator_bits_ <= 61 && denominator_bits_ + b_bits <= 63;
+    }
+
+    bool mul_fits(unsigned a_bits, unsigned b_bits) const {
+        return numerator_bits_ + a_bits <= 63 && denominator_bits_ + b_bits <= 63;
+    }
+
+    void add_exact(Fraction const &f) {
+        const std::optional<fraction_arith::Rational64> r = fraction_arith::add(
+            fraction_arith::Rational64{numerator_, denominator_},
+            fraction_arith::Rational64{f.get_numerator(), f.get_denominator()});
+        store_exact(r, "operator+=");
+    }
+
+    void mul_exact(Fraction const &f) {
+        const std::optional<fraction_arith::Rational64> r = fraction_arith::mul(
+            fraction_arith::Rational64{numerator_, denominator_},
+            fraction_arith::Rational64{f.get_numerator(), f.get_denominator()});
+        store_exact(r, "operator*=");
+    }
+
+    // INT64_MIN is rejected to keep |numerator_| < 2^63 (the bit width checks rely on it)
+    void store_exact(std::optional<fraction_arith::Rational64> r, const char *operation) {
+        if(!r || r->numerator == INT64_MIN)
+            throw std::overflow_error(std::string("FractionAccumulator overflow in ") + operation);
+        set(r->numerator, r->denominator);
+        pending_ = false;
+    }
+
+public:
+    FractionAccumulator() = default;
+
+    explicit FractionAccumulator(Fraction const &start) {
+        set(start.get_numerator(), start.get_denominator());
+        pending_ = true;   // Fraction's constructor doesn't simplify
+    }
+
+    FractionAccumulator& operator+=(Fraction const &f) {
+        const std::int64_t a = f.get_numerator();
+        const std::int64_t b = f.get_denominator();
+        const unsigned a_bits = bit_width(a);
+
+        if(b == denominator_ && numerator_bits_ <= 62 && a_bits <= 62) {
+            set(numerator_ + a, denominator_);
+            pending_ = true;
+            return *this;
+        }
+        const unsigned b_bits = bit_width(b);
+        if(!add_fits(a_bits, b_bits))
+            normalize();
+        if(!add_fits(a_bits, b_bits)) {
+            add_exact(f);
+            return *this;
+        }
+        set(numerator_ * b + a * denominator_, denominator_ * b);
+        pending_ = true;
+        return *this;
+    }
+
+    FractionAccumulator& operator*=(Fraction const &f) {
+        const std::int64_t a = f.get_numerator();
+        const std::int64_t b = f.get_denominator();
+        const unsigned a_bits = bit_width(a);
+        const unsigned b_bits = bit_width(b);
+        if(!mul_fits(a_bits, b_bits))
+            normalize();
+        if(!mul_fits(a_bits, b_bits)) {
+            mul_exact(f);
+            return *this;
+        }
+        set(numerator_ * a, denominator_ * b);
+        pending_ = true;
+        return *this;
+    }
+
+    // pre-increment: n/d + 1 = (n + d) / d, no gcd
+    FractionAccumulator& operator++() {
+        return *this += Fraction(1, 1);
+    }
+
+    // lowest terms, positive denominator
+    void normalize() const {
+        if(!pending_)
+            return;
+        std::int64_t n = numerator_;
+        std::int64_t d = denominator_;
+        const std::int64_t g = static_cast<std::int64_t>(
+            gcd_kernel::binary_gcd(fraction_arith::magnitude(n), fraction_arith::magnitude(d)));
+        if(g > 1) {
+            n /= g;
+            d /= g;
+        }
+        if(d < 0) {
+            n = -n;
+            d = -d;
+        }
+        set(n, d);
+        pending_ = false;
+        normalizations_++;
+    }
+
+    bool pending() const {
+        return pending_;
+    }
+
+    // how many gcd passes the accumulation has needed so far
+    std::size_t normalizations() const {
+        return normalizations_;
+    }
+
+    // the total as a Fraction in lowest terms; throws std::overflow_error if it doesn't fit in int
+    Fraction value() const {
+        normalize();
+        if(numerator_ < INT_MIN || numerator_ > INT_MAX || denominator_ > INT_MAX)
+            throw std::overflow_error("FractionAccumulator overflow in value");
+        return Fraction(static_cast<int>(numerator_), static_cast<int>(denominator_));
+    }
+
+    // canonical on both sides: equal values have equal numerators and denominators
+    bool operator==(FractionAccumulator const &other) const {
+        normalize();
+        other.normalize();
+        return numerator_ == other.numerator_ && denominator_ == other.denominator_;
+    }
+
+    bool operator==(Fraction const &f) const {
+        normalize();
+        return fraction_arith::equal(fraction_arith::Rational64{numerator_, denominator_},
+                                     fraction_arith::Rational64{f.get_numerator(), f.get_denominator()});
+    }
+
+    // same text as the eager Fraction total: lowest terms, sign on the numerator
+    friend std::ostream& operator<<(std::ostream &os, FractionAccumulator const &total) {
+        total.normalize();
+        os <<total.numerator_ <<'/' <<total.denominator_;
+        return os;
+    }
+};
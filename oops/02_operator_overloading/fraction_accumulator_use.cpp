@@ -0,0 +1,67 @@
+// build: g++ -std=c++20 -O2 fraction_accumulator_use.cpp
+// usage: ./a.out [terms]        (default 10M)
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "../01_basics/timing.h"
+#include "fraction_accumulator.h"
+
+// random terms a/b with b from a small set (prices in halves, thirds, quarters, ...):
+// the exact total stays small enough for a Fraction, so the eager loop never throws
+std::vector<Fraction> random_terms(std::size_t n, std::mt19937 &rng) {
+    constexpr int kDenominators[] = {1, 2, 3, 4, 5, 6, 8, 10, 12};
+    std::uniform_int_distribution<int> numerator(-9, 9);
+    std::uniform_int_distribution<int> pick(0, std::size(kDenominators) - 1);
+    std::vector<Fraction> terms;
+    terms.reserve(n);
+    for(std::size_t i = 0; i < n; i++)
+        terms.emplace_back(numerator(rng), kDenominators[pick(rng)]);
+    return terms;
+}
+
+int main(int argc, char **argv) {
+    FractionAccumulator total;
+    total += Fraction(1, 6);
+    total += Fraction(1, 10);
+    std::cout <<total.pending() <<'\n';                  // 1  (16/60 internally)
+    std::cout <<total <<'\n';                            // 4/15
+    std::cout <<(total == Fraction(8, 30)) <<'\n';       // 1
+    total *= Fraction(-15, 2);
+    ++total;
+    std::cout <<total <<' ' <<total.value() <<'\n';      // -1/1 -1/1
+
+
+    // ------------------------------------------------------------
+    // Benchmark: long running total, eager Fraction += vs FractionAccumulator
+    // ------------------------------------------------------------
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    std::mt19937 rng(1);
+    const std::vector<Fraction> terms = random_terms(n, rng);
+
+    Fraction eager(0, 1);
+    const double eager_ms = time_ms([&] {
+        for(const Fraction &f : terms)
+            eager += f;
+    });
+
+    FractionAccumulator lazy;
+    const double lazy_ms = time_ms([&] {
+        for(const Fraction &f : terms)
+            lazy += f;
+        lazy.normalize();
+    });
+
+    std::cout <<n <<" terms\n";
+    std::cout <<"Fraction +=:            " <<eager_ms <<" ms, " <<eager <<", 1 gcd per term\n";
+    std::cout <<"FractionAccumulator +=: " <<lazy_ms <<" ms, " <<lazy <<", "
+              <<lazy.normalizations() <<" gcds (1 per " <<n / (lazy.normalizations() ? lazy.normalizations() : 1) <<" terms)\n";
+    std::cout <<"same total: " <<(lazy == eager) <<", "
+              <<eager_ms / lazy_ms <<"x\n";
+    // 10M terms: Fraction += ~415 ms, FractionAccumulator ~150 ms (one gcd per ~20 terms), ~2.7x
+    // (~3.9x while Fraction's add was cross-reduced: two gcds per term, ~765 ms)
+
+    return 0;
+}
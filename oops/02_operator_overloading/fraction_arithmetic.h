@@ -0,0 +1,155 @@
+// overflow-safe rational arithmetic backend used by Fraction
+// cross-reduction by gcd BEFORE multiplying, 128-bit intermediates, checked results
+
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+
+#include "gcd_kernel.h"
+
+// The naive formulas (what Fraction used to do, in int):
+//   a/b + c/d = (a*d + c*b) / (b*d)          then divide by gcd
+//   a/b * c/d = (a*c) / (b*d)                then divide by gcd
+// The products are computed at FULL size and only reduced afterwards:
+//   1/6 + 1/10  ->  (10 + 6) / 60  ->  16/60  ->  4/15
+// After a few chained operations b*d exceeds INT_MAX and silently wraps (UB for signed int).
+//
+// Cross-reduction (Knuth, TAOCP vol. 2, 4.5.1):
+//   add:  g = gcd(b, d)                       6 and 10 -> g = 2
+//         a*(d/g) + c*(b/g)  over  (b/g)*d    1*5 + 1*3 = 8  over  3*10 = 30  -> 8/30
+//         then reduce by gcd(8, 30) = 2       -> 4/15
+//   mul:  g1 = gcd(a, d), g2 = gcd(c, b)
+//         (a/g1)*(c/g2)  over  (b/g2)*(d/g1)  -- already in lowest terms if the inputs were
+// Intermediates stay about as small as the RESULT, not the product of the operands,
+// and the final gcd works on smaller numbers (cheaper). It costs a gcd and two divisions per add, though:
+// for int-sized operands, which can't overflow 64 bits, add() skips it and reduces once at the end.
+//
+// Every intermediate is computed in 128 bits, so nothing can wrap; if the reduced
+// result doesn't fit the target width the operation reports overflow (std::nullopt).
+//
+// Results are canonical: lowest terms, denominator > 0 (so -1/2, never 1/-2).
+// Precondition everywhere: denominators are non-zero.
+
+namespace fraction_arith {
+
+struct Rational64 {
+    std::int64_t numerator;
+    std::int64_t denominator;
+};
+
+using int128 = __int128;             // GCC / Clang extension
+using uint128 = unsigned __int128;
+
+constexpr std::uint64_t magnitude(std::int64_t v) {
+    // well defined for INT64_MIN as well: -(uint64)v wraps modulo 2^64
+    return v < 0 ? 0 - static_cast<std::uint64_t>(v) : static_cast<std::uint64_t>(v);
+}
+
+constexpr uint128 magnitude(int128 v) {
+    return v < 0 ? 0 - static_cast<uint128>(v) : static_cast<uint128>(v);
+}
+
+constexpr std::uint64_t gcd(std::uint64_t a, std::uint64_t b) {
+    return gcd_kernel::binary_gcd(a, b);   // shifts and subtractions, no divisions (gcd_kernel.h)
+}
+
+constexpr uint128 gcd(uint128 a, uint128 b) {
+    while(b != 0 && ((a | b) >> 64) != 0) {   // Euclid in 128 bits only while an operand is that wide
+        const uint128 r = a % b;
+        a = b;
+        b = r;
+    }
+    if(b == 0)
+        return a;
+    return gcd(static_cast<std::uint64_t>(a), static_cast<std::uint64_t>(b));
+}
+
+constexpr bool fits_int64(int128 v) {
+    return v >= INT64_MIN && v <= INT64_MAX;
+}
+
+// lowest terms, positive denominator; nullopt if that doesn't fit in 64 bits
+constexpr std::optional<Rational64> reduce(int128 numerator, int128 denominator) {
+    if(denominator < 0) {
+        numerator = -numerator;
+        denominator = -denominator;
+    }
+    if(denominator <= INT64_MAX && fits_int64(numerator) && numerator != INT64_MIN) {
+        // common case: everything fits in 64 bits -> 64-bit gcd and divisions (128-bit division is a library call)
+        std::int64_t n = static_cast<std::int64_t>(numerator);
+        std::int64_t d = static_cast<std::int64_t>(denominator);
+        const std::int64_t g = static_cast<std::int64_t>(gcd(magnitude(n), static_cast<std::uint64_t>(d)));
+        if(g > 1) {
+            n /= g;
+            d /= g;
+        }
+        return Rational64{n, d};
+    }
+    const uint128 g = gcd(magnitude(numerator), static_cast<uint128>(denominator));
+    if(g > 1) {
+        numerator /= static_cast<int128>(g);
+        denominator /= static_cast<int128>(g);
+    }
+    if(!fits_int64(numerator) || !fits_int64(denominator))
+        return std::nullopt;
+    return Rational64{static_cast<std::int64_t>(numerator), static_cast<std::int64_t>(denominator)};
+}
+
+// |v| < 2^31: a product of two such values is below 2^62, a sum of two products below 2^63
+constexpr bool fits_int32(std::int64_t v) {
+    return v > INT32_MIN && v <= INT32_MAX;
+}
+
+constexpr std::optional<Rational64> add(Rational64 x, Rational64 y) {
+    if(fits_int32(x.numerator) && fits_int32(x.denominator) && fits_int32(y.numerator) && fits_int32(y.denominator)) {
+        // int-sized operands (every Fraction): nothing can overflow in 64 bits, so skip the cross-reduction --
+        // gcd(b, d) and two more divisions per add -- and reduce the plain a*d + c*b over b*d once
+        std::int64_t numerator = x.numerator * y.denominator + y.numerator * x.denominator;
+        std::int64_t denominator = x.denominator * y.denominator;
+        if(denominator < 0) {   // both below 2^62 in magnitude: negating can't overflow
+            numerator = -numerator;
+            denominator = -denominator;
+        }
+        // std::gcd: libstdc++'s is binary as well, and on these operands measured faster than gcd_kernel's
+        const std::int64_t g = std::gcd(numerator, denominator);
+        return Rational64{numerator / g, denominator / g};
+    }
+    const std::int64_t g = static_cast<std::int64_t>(gcd(magnitude(x.denominator), magnitude(y.denominator)));
+    if(g == 1) {   // coprime denominators: nothing to cross-reduce, and no divisions by 1
+        return reduce(static_cast<int128>(x.numerator) * y.denominator + static_cast<int128>(y.numerator) * x.denominator,
+                      static_cast<int128>(x.denominator) * y.denominator);
+    }
+    const int128 numerator = static_cast<int128>(x.numerator) * (y.denominator / g)
+                           + static_cast<int128>(y.numerator) * (x.denominator / g);
+    const int128 denominator = static_cast<int128>(x.denominator / g) * y.denominator;
+    return reduce(numerator, denominator);
+}
+
+constexpr std::optional<Rational64> mul(Rational64 x, Rational64 y) {
+    // never 0: the denominators are non-zero
+    const std::int64_t g1 = static_cast<std::int64_t>(gcd(magnitude(x.numerator), magnitude(y.denominator)));
+    const std::int64_t g2 = static_cast<std::int64_t>(gcd(magnitude(y.numerator), magnitude(x.denominator)));
+    const int128 numerator = static_cast<int128>(x.numerator / g1) * (y.numerator / g2);
+    const int128 denominator = static_cast<int128>(x.denominator / g2) * (y.denominator / g1);
+    return reduce(numerator, denominator);
+}
+
+// exact: a/b == c/d  <=>  a*d == c*b   (128-bit products can't overflow for 64-bit inputs)
+constexpr bool equal(Rational64 x, Rational64 y) {
+    return static_cast<int128>(x.numerator) * y.denominator == static_cast<int128>(y.numerator) * x.denominator;
+}
+
+// exact: a/b < c/d  <=>  a*d < c*b  when b*d > 0; the comparison flips when exactly one denominator is negative
+// weak, not strong: 1/2 and 2/4 are equivalent but not the same representation
+constexpr std::weak_ordering compare(Rational64 x, Rational64 y) {
+    const int128 lhs = static_cast<int128>(x.numerator) * y.denominator;
+    const int128 rhs = static_cast<int128>(y.numerator) * x.denominator;
+    if((x.denominator < 0) != (y.denominator < 0))
+        return rhs <=> lhs;
+    return lhs <=> rhs;
+}
+
+}   // namespace fraction_arith
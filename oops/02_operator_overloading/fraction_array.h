@@ -0,0 +1,303 @@
+// columnar array of fractions for bulk arithmetic
+// numerator / denominator columns, element-wise ops without per-element gcd, one normalize() pass per batch
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "fraction.h"
+#include "fraction_arithmetic.h"
+#include "gcd_kernel.h"
+
+// Columns instead of std::vector<Fraction>:
+//   numerators_   : [ n0 | n1 | n2 | ... ]   int64, room for unreduced products
+//   denominators_ : [ d0 | d1 | d2 | ... ]
+// a += b  is  n = a.n*b.d + b.n*a.d,  d = a.d*b.d  per element: no branches, so the loop vectorizes.
+// Results are left UNREDUCED; normalize() does the gcds once for the whole batch (gcd_kernel::reduce_batch
+// when every value fits in 31 bits, the scalar binary gcd otherwise). The batch is SIMD only in a -mavx2
+// build; without it reduce_batch is the scalar gcd too, and normalize() takes ~3x as long.
+//
+// bits_ bounds the bit width of every |numerator| and |denominator|:
+//   add: bits(a*d + c*b) <= bits_a + bits_b + 1        mul: bits(a*c) <= bits_a + bits_b
+// While the bound is <= 63 nothing can overflow. Past it, the operation normalizes first, and if that isn't
+// enough, uses the exact per-element path (fraction_arith, 128-bit): std::overflow_error on a real overflow.
+
+class FractionArray {
+
+private:
+    std::vector<std::int64_t> numerators_;
+    std::vector<std::int64_t> denominators_;
+    unsigned bits_ = 0;      // bit width bound of every |value|, always <= 63
+    bool pending_ = false;   // some elements may not be in lowest terms / have a negative denominator
+
+    static constexpr unsigned kMaxBits = 63;
+
+    static unsigned bit_width(std::int64_t v) {
+        return static_cast<unsigned>(std::bit_width(fraction_arith::magnitude(v)));
+    }
+
+    void check_same_size(const FractionArray &other, const char *operation) const {
+        if(other.size() != size())
+            throw std::invalid_argument(std::string("FractionArray size mismatch in ") + operation);
+    }
+
+    // exact bound, one OR-reduction over both columns (vectorizable)
+    void recompute_bits() {
+        std::uint64_t all = 0;
+        for(std::size_t i = 0; i < size(); i++)
+            all |= fraction_arith::magnitude(numerators_[i]) | fraction_arith::magnitude(denominators_[i]);
+        bits_ = static_cast<unsigned>(std::bit_width(all));
+    }
+
+    // stores a result of the exact path; INT64_MIN is rejected to keep every |value| < 2^63
+    void store_exact(std::size_t i, std::optional<fraction_arith::Rational64> r, const char *operation) {
+        if(!r || r->numerator == INT64_MIN)
+            throw std::overflow_error(std::string("FractionArray overflow in ") + operation);
+        numerators_[i] = r->numerator;
+        denominators_[i] = r->denominator;
+    }
+
+    template <typename Op>
+    void apply_exact(const FractionArray &other, Op op, const char *operation) {
+        for(std::size_t i = 0; i < size(); i++)
+            store_exact(i, op(element(i), other.element(i)), operation);
+        pending_ = false;   // fraction_arith results are canonical
+        recompute_bits();
+    }
+
+    static Fraction narrow(fraction_arith::Rational64 r, const char *operation) {
+        if(r.numerator < INT_MIN || r.numerator > INT_MAX || r.denominator > INT_MAX)
+            throw std::overflow_error(std::string("FractionArray overflow in ") + operation);
+        return Fraction(static_cast<int>(r.numerator), static_cast<int>(r.denominator));
+    }
+
+    fraction_arith::Rational64 element(std::size_t i) const {
+        return fraction_arith::Rational64{numerators_[i], denominators_[i]};
+    }
+
+    void normalize_scalar() {
+        for(std::size_t i = 0; i < size(); i++) {
+            std::int64_t n = numerators_[i];
+            std::int64_t d = denominators_[i];
+            const std::int64_t g = static_cast<std::int64_t>(
+                gcd_kernel::binary_gcd(fraction_arith::magnitude(n), fraction_arith::magnitude(d)));
+            if(g > 1) {
+                n /= g;
+                d /= g;
+            }
+            if(d < 0) {
+                n = -n;
+                d = -d;
+            }
+            numerators_[i] = n;
+            denominators_[i] = d;
+        }
+    }
+
+    void normalize_simd() {
+        // every value fits in 31 bits: narrow a block to int32, reduce 8 at a time, widen back
+        constexpr std::size_t kBlock = 256;
+        std::int32_t numerators[kBlock];
+        std::int32_t denominators[kBlock];
+        for(std::size_t start = 0; start < size(); start += kBlock) {
+            const std::size_t n = std::min(kBlock, size() - start);
+            for(std::size_t i = 0; i < n; i++) {
+                numerators[i] = static_cast<std::int32_t>(numerators_[start + i]);
+                denominators[i] = static_cast<std::int32_t>(denominators_[start + i]);
+            }
+            gcd_kernel::reduce_batch(numerators, denominators, n);
+            for(std::size_t i = 0; i < n; i++) {
+                numerators_[start + i] = numerators[i];
+                denominators_[start + i] = denominators[i];
+            }
+        }
+    }
+
+public:
+    FractionArray() = default;
+
+    explicit FractionArray(std::span<const Fraction> fractions) {
+        reserve(fractions.size());
+        for(const Fraction &f : fractions)
+            push_back(f);
+    }
+
+    void reserve(std::size_t n) {
+        numerators_.reserve(n);
+        denominators_.reserve(n);
+    }
+
+    // stored as given (like Fraction's constructor, no simplify), so the array starts out pending
+    void push_back(Fraction const &f) {
+        numerators_.push_back(f.get_numerator());
+        denominators_.push_back(f.get_denominator());
+        bits_ = std::max({bits_, bit_width(f.get_numerator()), bit_width(f.get_denominator())});
+        pending_ = true;
+    }
+
+    std::size_t size() const {
+        return numerators_.size();
+    }
+
+    bool empty() const {
+        return numerators_.empty();
+    }
+
+    bool pending() const {
+        return pending_;
+    }
+
+    // raw columns (elements may be unreduced while pending())
+    std::span<const std::int64_t> numerators() const {
+        return numerators_;
+    }
+
+    std::span<const std::int64_t> denominators() const {
+        return denominators_;
+    }
+
+    // element i in lowest terms; throws std::overflow_error if it doesn't fit in a Fraction (int)
+    Fraction operator[](std::size_t i) const {
+        const std::optional<fraction_arith::Rational64> r = fraction_arith::reduce(numerators_[i], denominators_[i]);
+        if(!r)
+            throw std::overflow_error("FractionArray overflow in operator[]");
+        return narrow(*r, "operator[]");
+    }
+
+    std::vector<Fraction> to_fractions() const {
+        std::vector<Fraction> fractions;
+        fractions.reserve(size());
+        for(std::size_t i = 0; i < size(); i++)
+            fractions.push_back((*this)[i]);
+        return fractions;
+    }
+
+    // every element to lowest terms with a positive denominator
+    void normalize() {
+        if(!pending_)
+            return;
+        recompute_bits();   // the bound from the operations is loose, the SIMD path needs the real width
+        if(bits_ <= 31)
+            normalize_simd();
+        else
+            normalize_scalar();
+        pending_ = false;
+        recompute_bits();
+    }
+
+
+    // element-wise arithmetic: this[i] = this[i] op other[i], results left pending
+
+    FractionArray& operator+=(FractionArray const &other) {
+        check_same_size(other, "operator+=");
+        if(bits_ + other.bits_ + 1 > kMaxBits)
+            normalize();
+        if(bits_ + other.bits_ + 1 > kMaxBits) {
+            apply_exact(other, fraction_arith::add, "operator+=");
+            return *this;
+        }
+
+        const std::int64_t *other_numerators = other.numerators_.data();
+        const std::int64_t *other_denominators = other.denominators_.data();
+        for(std::size_t i = 0; i < size(); i++) {
+            const std::int64_t n = numerators_[i];
+            const std::int64_t d = denominators_[i];
+            numerators_[i] = n * other_denominators[i] + other_numerators[i] * d;
+            denominators_[i] = d * other_denominators[i];
+        }
+        bits_ += other.bits_ + 1;
+        pending_ = true;
+        return *this;
+    }
+
+    FractionArray& operator*=(FractionArray const &other) {
+        check_same_size(other, "operator*=");
+        if(bits_ + other.bits_ > kMaxBits)
+            normalize();
+        if(bits_ + other.bits_ > kMaxBits) {
+            apply_exact(other, fraction_arith::mul, "operator*=");
+            return *this;
+        }
+
+        const std::int64_t *other_numerators = other.numerators_.data();
+        const std::int64_t *other_denominators = other.denominators_.data();
+        for(std::size_t i = 0; i < size(); i++) {
+            numerators_[i] *= other_numerators[i];
+            denominators_[i] *= other_denominators[i];
+        }
+        bits_ += other.bits_;
+        pending_ = true;
+        return *this;
+    }
+
+    friend FractionArray operator+(FractionArray lhs, FractionArray const &rhs) {
+        lhs += rhs;
+        return lhs;
+    }
+
+    friend FractionArray operator*(FractionArray lhs, FractionArray const &rhs) {
+        lhs *= rhs;
+        return lhs;
+    }
+
+    // out[i] = sign(this[i] - other[i]): -1, 0 or 1. Works on pending elements too (no normalize needed):
+    //   a/b - c/d  has the sign of  (a*d - c*b) * b*d
+    void compare(FractionArray const &other, std::span<std::int8_t> out) const {
+        check_same_size(other, "compare");
+        if(out.size() < size())
+            throw std::invalid_argument("FractionArray::compare: output span too small");
+
+        if(bits_ + other.bits_ + 1 <= kMaxBits) {
+            // the cross products fit in 64 bits: vectorizable
+            for(std::size_t i = 0; i < size(); i++) {
+                const std::int64_t difference = numerators_[i] * other.denominators_[i] - other.numerators_[i] * denominators_[i];
+                const bool negative_denominators = (denominators_[i] < 0) != (other.denominators_[i] < 0);
+                const std::int8_t sign = static_cast<std::int8_t>((difference > 0) - (difference < 0));
+                out[i] = negative_denominators ? static_cast<std::int8_t>(-sign) : sign;
+            }
+            return;
+        }
+        for(std::size_t i = 0; i < size(); i++) {
+            const fraction_arith::int128 difference = static_cast<fraction_arith::int128>(numerators_[i]) * other.denominators_[i]
+                                                    - static_cast<fraction_arith::int128>(other.numerators_[i]) * denominators_[i];
+            const bool negative_denominators = (denominators_[i] < 0) != (other.denominators_[i] < 0);
+            const std::int8_t sign = static_cast<std::int8_t>((difference > 0) - (difference < 0));
+            out[i] = negative_denominators ? static_cast<std::int8_t>(-sign) : sign;
+        }
+    }
+
+
+    // reductions: exact, cross-reduced fold in 64 bits (fraction_arith), the result narrowed to Fraction
+    // throw std::overflow_error if a partial result doesn't fit in 64 bits or the total doesn't fit in int
+
+    Fraction sum() const {
+        fraction_arith::Rational64 total{0, 1};
+        for(std::size_t i = 0; i < size(); i++) {
+            const std::optional<fraction_arith::Rational64> next = fraction_arith::add(total, element(i));
+            if(!next)
+                throw std::overflow_error("FractionArray overflow in sum");
+            total = *next;
+        }
+        return narrow(total, "sum");
+    }
+
+    Fraction product() const {
+        fraction_arith::Rational64 total{1, 1};
+        for(std::size_t i = 0; i < size(); i++) {
+            const std::optional<fraction_arith::Rational64> next = fraction_arith::mul(total, element(i));
+            if(!next)
+                throw std::overflow_error("FractionArray overflow in product");
+            total = *next;
+        }
+        return narrow(total, "product");
+    }
+};
@@ -0,0 +1,114 @@
+// build: g++ -std=c++20 -O2 -mavx2 fraction_array_use.cpp     (SIMD gcds: the ~4x below)
+//        g++ -std=c++20 -O2 fraction_array_use.cpp            (scalar gcds: ~1.5x, the 4x target is missed)
+// usage: ./a.out [elements]        (default 10M)
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "../01_basics/timing.h"
+#include "fraction_array.h"
+
+std::vector<Fraction> random_fractions(std::size_t n, int limit, std::mt19937 &rng) {
+    std::uniform_int_distribution<int> numerator(-limit, limit);
+    std::uniform_int_distribution<int> denominator(1, limit);
+    std::vector<Fraction> fractions;
+    fractions.reserve(n);
+    for(std::size_t i = 0; i < n; i++)
+        fractions.emplace_back(numerator(rng), denominator(rng));
+    return fractions;
+}
+
+bool same(const std::vector<Fraction> &expected, const FractionArray &got) {
+    for(std::size_t i = 0; i < expected.size(); i++) {
+        const Fraction f = got[i];
+        if(f.get_numerator() != expected[i].get_numerator() || f.get_denominator() != expected[i].get_denominator())
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    const std::vector<Fraction> small{Fraction(1, 6), Fraction(2, 3), Fraction(1, -2)};
+    const std::vector<Fraction> other{Fraction(1, 10), Fraction(9, 4), Fraction(1, 2)};
+    FractionArray x(small);
+    const FractionArray y(other);
+
+    FractionArray s = x + y;
+    std::cout <<s.pending() <<": " <<s.numerators()[0] <<'/' <<s.denominators()[0] <<'\n';   // 1: 16/60 (unreduced)
+    s.normalize();
+    std::cout <<s.pending() <<": " <<s[0] <<' ' <<s[1] <<' ' <<s[2] <<'\n';                   // 0: 4/15 35/12 0/1
+    std::cout <<(x * y)[1] <<'\n';                                                          // 3/2
+
+    std::vector<std::int8_t> order(x.size());
+    x.compare(y, order);
+    std::cout <<int(order[0]) <<' ' <<int(order[1]) <<' ' <<int(order[2]) <<'\n';           // 1 -1 -1
+    std::cout <<x.sum() <<' ' <<x.product() <<'\n';                                        // 1/3 -1/18
+
+
+    // ------------------------------------------------------------
+    // Benchmark: c[i] = a[i] + b[i], loop of Fraction::operator+ vs FractionArray
+    // ------------------------------------------------------------
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    std::mt19937 rng(42);
+    // 15-bit numerators / denominators: every sum fits back into a Fraction (int)
+    const std::vector<Fraction> a = random_fractions(n, (1 << 15) - 1, rng);
+    const std::vector<Fraction> b = random_fractions(n, (1 << 15) - 1, rng);
+
+    std::vector<Fraction> c(n, Fraction(0, 1));
+    const double loop_ms = time_ms([&] {
+        for(std::size_t i = 0; i < n; i++)
+            c[i] = a[i] + b[i];
+    });
+
+    FractionArray array_a(a);
+    const FractionArray array_b(b);
+    array_a.normalize();   // inputs canonical like the Fraction results, not timed
+    const double add_ms = time_ms([&] {
+        array_a += array_b;
+    });
+    const double normalize_ms = time_ms([&] {
+        array_a.normalize();
+    });
+
+    std::cout <<n <<" additions\n";
+    std::cout <<"loop of Fraction::operator+: " <<loop_ms <<" ms\n";
+    std::cout <<"FractionArray +=:            " <<add_ms <<" ms (pending)\n";
+    std::cout <<"  + normalize():             " <<normalize_ms <<" ms\n";
+    std::cout <<"  total:                     " <<add_ms + normalize_ms <<" ms, "
+              <<loop_ms / (add_ms + normalize_ms) <<"x, same results: " <<same(c, array_a) <<'\n';
+    // 10M, -mavx2:     loop ~1250-1500 ms; += ~30 ms, normalize() ~280-300 ms (every value fits 31 bits:
+    //                  SIMD gcds), ~4.1-4.5x
+    // 10M, no -mavx2:  normalize() is the scalar binary gcd, ~780-840 ms: ~1.4-1.9x -- the 4x target is missed
+    // values wider than 31 bits normalize through the scalar binary gcd either way: ~1.6x
+
+
+    // a chain of operations pays for normalization once: d[i] = a[i] * b[i] + c[i]
+    // (10-bit inputs so every result still fits in int)
+    const std::vector<Fraction> p = random_fractions(n, (1 << 10) - 1, rng);
+    const std::vector<Fraction> q = random_fractions(n, (1 << 10) - 1, rng);
+    const std::vector<Fraction> r = random_fractions(n, (1 << 10) - 1, rng);
+    std::vector<Fraction> d(n, Fraction(0, 1));
+    const double chain_loop_ms = time_ms([&] {
+        for(std::size_t i = 0; i < n; i++)
+            d[i] = p[i] * q[i] + r[i];
+    });
+
+    FractionArray array_p(p);
+    const FractionArray array_q(q);
+    const FractionArray array_r(r);
+    array_p.normalize();
+    const double chain_array_ms = time_ms([&] {
+        array_p *= array_q;
+        array_p += array_r;
+        array_p.normalize();
+    });
+    std::cout <<"\n" <<n <<" x (a*b + c)\n";
+    std::cout <<"loop of Fraction operators:  " <<chain_loop_ms <<" ms\n";
+    std::cout <<"FractionArray, 1 normalize:  " <<chain_array_ms <<" ms, "
+              <<chain_loop_ms / chain_array_ms <<"x, same results: " <<same(d, array_p) <<'\n';
+    // 10M, -mavx2: loop ~2470-2870 ms, FractionArray ~310-350 ms, ~7.9-8.1x;  no -mavx2: ~770 ms, ~3.0-3.5x
+
+    return 0;
+}
@@ -0,0 +1,31 @@
+// batched TSV / CSV export of Fractions through BufferedWriter
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include "../01_basics/buffered_writer.h"
+#include "fraction.h"
+
+// every field is exactly what operator<< prints: numerator/denominator
+// fields_per_line fractions per record, separated by \t (Tsv) or , (Csv)
+//   fields_per_line = 1:   1/4 \n 3/8 \n ...          same as  std::cout << f << '\n'  per fraction
+
+inline void export_fraction(BufferedWriter &out, const Fraction &f) {
+    out.write_int(f.get_numerator());
+    out.put('/');
+    out.write_int(f.get_denominator());
+}
+
+inline void export_fractions(BufferedWriter &out, std::span<const Fraction> fractions,
+                             ExportFormat format = ExportFormat::Tsv, std::size_t fields_per_line = 1) {
+    if(fields_per_line == 0)
+        fields_per_line = 1;
+    const char sep = BufferedWriter::separator(format);   // "a/b" never needs CSV quoting
+    for(std::size_t i = 0; i < fractions.size(); i++) {
+        export_fraction(out, fractions[i]);
+        const bool last_in_line = (i + 1) % fields_per_line == 0 || i + 1 == fractions.size();
+        out.put(last_in_line ? '\n' : sep);
+    }
+}
@@ -0,0 +1,46 @@
+// build: g++ -std=c++20 -O2 fraction_export_use.cpp
+
+#include <iostream>
+#include <vector>
+
+#include "../01_basics/dev_null_timing.h"
+#include "fraction_export.h"
+
+constexpr int kFractions = 5'000'000;
+
+int main() {
+    std::vector<Fraction> fractions{Fraction(1, 4), Fraction(3, 8), Fraction(-2, 5)};
+
+    std::cout <<fractions[0] <<'\n' <<fractions[1] <<'\n' <<fractions[2] <<'\n';
+    std::cout.flush();   // std::cout and the writer share fd 1: keep them in order
+    {
+        BufferedWriter out;
+        export_fractions(out, fractions);                        // same three lines as above
+        export_fractions(out, fractions, ExportFormat::Csv, 3);  // 1/4,3/8,-2/5
+    }
+
+
+    // ------------------------------------------------------------
+    // Benchmark: per-object operator<< through std::cout vs batched export
+    // ------------------------------------------------------------
+    std::vector<Fraction> many;
+    many.reserve(kFractions);
+    for(int i = 1; i <= kFractions; i++)
+        many.emplace_back(i, i % 997 + 1);
+
+    const double stream_ms = time_to_dev_null_ms([&] {
+        for(const Fraction &f : many)
+            std::cout <<f <<'\n';
+    });
+    const double batched_ms = time_to_dev_null_ms([&] {
+        BufferedWriter out;
+        export_fractions(out, many);
+    });
+
+    std::cout <<kFractions <<" fractions\n";
+    std::cout <<"std::cout << f:     " <<stream_ms <<" ms\n";
+    std::cout <<"export_fractions(): " <<batched_ms <<" ms\n";
+    std::cout <<"speedup: " <<stream_ms / batched_ms <<"x\n";
+
+    return 0;
+}
@@ -0,0 +1,160 @@
+// bulk ingest of whitespace-separated fractions (what operator<< / export_fractions write)
+// memory-mapped input, split into chunks, parsed in parallel with parse_fraction, errors with positions
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "../01_basics/mapped_file.h"
+#include "fraction.h"
+#include "fraction_parse.h"
+
+// load_fractions, instead of  while(file >> f)  (a sentry, a locale lookup and a std::string per token):
+//   1. mmap the file (MappedFile)
+//   2. one chunk per thread, each cut moved forward to the next whitespace so no token is split
+//   3. each thread parses its chunk with parse_fraction (std::from_chars) into its own vector
+//   4. the vectors are concatenated in chunk order: the file's order
+// A bad token is recorded (byte offset, line, column, reason) and skipped; the load goes on.
+
+struct FractionParseError {
+    std::size_t offset;   // byte offset of the token in the input
+    std::size_t line;     // 1-based
+    std::size_t column;   // 1-based, in bytes
+    std::errc reason;     // invalid_argument or result_out_of_range, as from parse_fraction
+    std::string token;
+};
+
+struct FractionLoadResult {
+    std::vector<Fraction> fractions;
+    std::vector<FractionParseError> errors;   // in input order
+
+    bool ok() const {
+        return errors.empty();
+    }
+};
+
+namespace fraction_loader_detail {
+
+constexpr bool is_space(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+}
+
+struct ChunkResult {
+    std::vector<Fraction> fractions;
+    std::vector<FractionParseError> errors;   // offset and reason only, line/column filled in later
+};
+
+inline void parse_chunk(std::string_view text, std::size_t begin, std::size_t end, ChunkResult &out) {
+    const char *const base = text.data();
+    const char *p = base + begin;
+    const char *const last = base + end;
+    // rough size guess: ~8 bytes per token and separator
+    out.fractions.reserve((end - begin) / 8);
+
+    Fraction value(0, 1);
+    while(true) {
+        while(p != last && is_space(*p))
+            p++;
+        if(p == last)
+            break;
+        // parse straight away (one pass over the bytes); a valid token ends at whitespace or the end
+        const std::from_chars_result result = parse_fraction(p, last, value);
+        if(result.ec == std::errc{} && (result.ptr == last || is_space(*result.ptr))) {
+            out.fractions.push_back(value);
+            p = result.ptr;
+            continue;
+        }
+        // bad token: find where it ends, record it, carry on after it
+        const char *token_end = p;
+        while(token_end != last && !is_space(*token_end))
+            token_end++;
+        const std::errc reason = result.ec == std::errc{} ? std::errc::invalid_argument : result.ec;   // trailing garbage
+        out.errors.push_back(FractionParseError{static_cast<std::size_t>(p - base), 0, 0, reason, std::string(p, token_end)});
+        p = token_end;
+    }
+}
+
+// one pass over the text, only as far as the last error
+inline void fill_line_numbers(std::string_view text, std::vector<FractionParseError> &errors) {
+    std::size_t line = 1;
+    std::size_t line_start = 0;
+    std::size_t scanned = 0;
+    for(FractionParseError &error : errors) {
+        for(; scanned < error.offset; scanned++) {
+            if(text[scanned] == '\n') {
+                line++;
+                line_start = scanned + 1;
+            }
+        }
+        error.line = line;
+        error.column = error.offset - line_start + 1;
+    }
+}
+
+}   // namespace fraction_loader_detail
+
+
+// threads = 0: one per hardware thread
+inline FractionLoadResult load_fractions(std::string_view text, unsigned threads = 0) {
+    if(threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    // not worth a thread for less than ~1 MB
+    constexpr std::size_t kMinChunk = 1 << 20;
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, text.size() / kMinChunk + 1));
+
+    // chunk boundaries, each moved forward to whitespace (or the end)
+    std::vector<std::size_t> cuts(threads + 1, text.size());
+    cuts[0] = 0;
+    for(unsigned t = 1; t < threads; t++) {
+        std::size_t cut = std::max(cuts[t - 1], text.size() / threads * t);
+        while(cut < text.size() && !fraction_loader_detail::is_space(text[cut]))
+            cut++;
+        cuts[t] = cut;
+    }
+
+    std::vector<fraction_loader_detail::ChunkResult> chunks(threads);
+    if(threads == 1) {
+        fraction_loader_detail::parse_chunk(text, 0, text.size(), chunks[0]);
+    }
+    else {
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for(unsigned t = 0; t < threads; t++)
+            workers.emplace_back(fraction_loader_detail::parse_chunk, text, cuts[t], cuts[t + 1], std::ref(chunks[t]));
+        for(std::thread &worker : workers)
+            worker.join();
+    }
+
+    FractionLoadResult result;
+    if(threads == 1) {
+        result.fractions = std::move(chunks[0].fractions);
+        result.errors = std::move(chunks[0].errors);
+    }
+    else {
+        std::size_t total = 0;
+        for(const auto &chunk : chunks)
+            total += chunk.fractions.size();
+        result.fractions.reserve(total);
+        for(auto &chunk : chunks) {
+            result.fractions.insert(result.fractions.end(), chunk.fractions.begin(), chunk.fractions.end());
+            std::move(chunk.errors.begin(), chunk.errors.end(), std::back_inserter(result.errors));
+        }
+    }
+    fraction_loader_detail::fill_line_numbers(text, result.errors);
+    return result;
+}
+
+// throws std::system_error if the file can't be opened / mapped
+inline FractionLoadResult load_fractions_file(const std::string &path, unsigned threads = 0) {
+    const MappedFile file(path);
+    file.advise_sequential();
+    return load_fractions(file.view(), threads);
+}
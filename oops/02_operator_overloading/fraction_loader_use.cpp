@@ -0,0 +1,106 @@
+// build: g++ -std=c++20 -O2 -pthread fraction_loader_use.cpp
+// usage: ./a.out [fractions]        (default 20M, ~200 MB of text in /tmp)
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "../01_basics/timing.h"
+#include "fraction_export.h"
+#include "fraction_loader.h"
+
+bool same(const std::vector<Fraction> &a, const std::vector<Fraction> &b) {
+    if(a.size() != b.size())
+        return false;
+    for(std::size_t i = 0; i < a.size(); i++) {
+        if(a[i].get_numerator() != b[i].get_numerator() || a[i].get_denominator() != b[i].get_denominator())
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    // single values: from_chars style and operator>>
+    const std::string text = "-3/4";
+    Fraction f(0, 1);
+    const std::from_chars_result result = parse_fraction(text.data(), text.data() + text.size(), f);
+    std::cout <<f <<' ' <<(result.ec == std::errc{}) <<'\n';          // -3/4 1
+
+    std::istringstream in("1/2 7/-8 oops 5/6");
+    Fraction a(0, 1), b(0, 1), c(0, 1);
+    in >>a >>b;
+    std::cout <<a <<' ' <<b <<'\n';                                     // 1/2 7/-8
+    in >>c;
+    std::cout <<in.fail() <<' ' <<c <<'\n';                             // 1 0/1   (failbit, c untouched)
+
+    // bulk, with errors reported where they are
+    const FractionLoadResult loaded = load_fractions("1/2 3/4\n5/0 6/7 x/2\n99999999999/1 -1/3\n");
+    std::cout <<loaded.fractions.size() <<" fractions\n";               // 4 fractions
+    for(const FractionParseError &error : loaded.errors)
+        std::cout <<"line " <<error.line <<", column " <<error.column <<": '" <<error.token <<"' "
+                  <<std::make_error_code(error.reason).message() <<'\n';
+    // line 2, column 1: '5/0' Invalid argument
+    // line 2, column 9: 'x/2' Invalid argument
+    // line 3, column 1: '99999999999/1' Numerical result out of range
+
+
+    // ------------------------------------------------------------
+    // Benchmark: istream >> vs load_fractions_file (mmap + from_chars, 1 and N threads)
+    // ------------------------------------------------------------
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20'000'000;
+    const std::string path = "/tmp/fractions.tsv";
+    std::vector<Fraction> fractions;
+    {
+        std::mt19937 rng(11);
+        std::uniform_int_distribution<int> numerator(-100000, 100000);
+        std::uniform_int_distribution<int> denominator(1, 100000);
+        fractions.reserve(n);
+        for(std::size_t i = 0; i < n; i++)
+            fractions.emplace_back(numerator(rng), denominator(rng));
+        const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        BufferedWriter out(fd);
+        export_fractions(out, fractions, ExportFormat::Tsv, 8);   // 8 per line, tab separated
+        out.flush();
+        ::close(fd);
+    }
+    const MappedFile probe(path);
+    const double megabytes = static_cast<double>(probe.size()) / (1 << 20);
+
+    std::vector<Fraction> streamed;
+    const double stream_ms = time_ms([&] {
+        std::ifstream file(path);
+        Fraction value(0, 1);
+        while(file >> value)
+            streamed.push_back(value);
+    });
+
+    FractionLoadResult one;
+    const double one_ms = time_ms([&] {
+        one = load_fractions_file(path, 1);
+    });
+
+    const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    FractionLoadResult all;
+    const double all_ms = time_ms([&] {
+        all = load_fractions_file(path, threads);
+    });
+
+    std::cout <<n <<" fractions, " <<megabytes <<" MB\n";
+    std::cout <<"istream >>:                  " <<stream_ms <<" ms, " <<megabytes / stream_ms * 1000 <<" MB/s\n";
+    std::cout <<"load_fractions_file, 1 thread: " <<one_ms <<" ms, " <<megabytes / one_ms * 1000 <<" MB/s\n";
+    std::cout <<"load_fractions_file, " <<threads <<" threads: " <<all_ms <<" ms, " <<megabytes / all_ms * 1000 <<" MB/s\n";
+    std::cout <<"same values: " <<(same(streamed, fractions) && same(one.fractions, fractions) && same(all.fractions, fractions))
+              <<", errors: " <<one.errors.size() + all.errors.size() <<'\n';
+    // 20M fractions (234 MB), one core: istream >> ~120 MB/s, load_fractions_file ~390 MB/s (3.2x);
+    // most of what's left is std::from_chars itself, and the chunks scale with the number of cores
+
+    ::unlink(path.c_str());
+    return 0;
+}
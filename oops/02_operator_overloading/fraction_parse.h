@@ -0,0 +1,56 @@
+// reading Fractions back: from_chars-style parser and operator>>
+// accepts exactly what operator<< writes: numerator/denominator, e.g. 3/4, -1/2, 5/-7
+
+#pragma once
+
+#include <charconv>
+#include <istream>
+#include <string>
+#include <system_error>
+
+#include "fraction.h"
+
+// Same contract as std::from_chars (and built on it):
+//   - parses one fraction at the START of [first, last): no leading whitespace, no '+' signs
+//   - on success: ec == std::errc{}, ptr = one past the last character used, value is set
+//   - on failure: value is untouched, and
+//       ec == std::errc::invalid_argument      not a fraction (ptr == first), or a zero denominator (ptr after it)
+//       ec == std::errc::result_out_of_range   numerator or denominator doesn't fit in int (ptr after the number)
+// No locale, no allocation, no exceptions -- it can run on millions of tokens per second.
+// The value is stored as written (like the constructor: not simplified), so parse(print(f)) gives back f exactly.
+
+inline std::from_chars_result parse_fraction(const char *first, const char *last, Fraction &value) {
+    int numerator = 0;
+    const std::from_chars_result n = std::from_chars(first, last, numerator);
+    if(n.ec != std::errc{})
+        return n;
+    if(n.ptr == last || *n.ptr != '/')
+        return {first, std::errc::invalid_argument};
+
+    int denominator = 0;
+    const std::from_chars_result d = std::from_chars(n.ptr + 1, last, denominator);
+    if(d.ec == std::errc::invalid_argument)
+        return {first, std::errc::invalid_argument};
+    if(d.ec != std::errc{})
+        return d;
+    if(denominator == 0)
+        return {d.ptr, std::errc::invalid_argument};
+
+    value = Fraction(numerator, denominator);
+    return {d.ptr, std::errc{}};
+}
+
+// Overloading >>
+// reads one whitespace-separated token; sets failbit (and leaves f unchanged) if it isn't a whole fraction
+inline std::istream& operator>>(std::istream &is, Fraction &f) {
+    std::string token;
+    if(!(is >> token))
+        return is;
+    Fraction parsed = f;
+    const std::from_chars_result result = parse_fraction(token.data(), token.data() + token.size(), parsed);
+    if(result.ec != std::errc{} || result.ptr != token.data() + token.size())
+        is.setstate(std::ios::failbit);
+    else
+        f = parsed;
+    return is;
+}
@@ -0,0 +1,177 @@
+// exact parallel sum / product of a Fraction array: fraction_reduce(terms, std::plus<>{})
+// tree-shaped, terms with similar denominators combined first, 64-bit fast path, BigFraction above it
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "big_fraction.h"
+#include "big_int.h"
+#include "fraction.h"
+#include "fraction_arithmetic.h"
+
+// A plain  total += f  loop overflows Fraction's int (H(30) already needs 42 bits), and in BigFraction
+// every step works on the whole, growing total, one step after another. fraction_reduce instead:
+//   1. canonicalizes the terms to 64-bit (lowest terms, positive denominator)
+//   2. for sums, sorts them by denominator, so terms with equal / close denominators are added together
+//   3. gives each thread one contiguous chunk, reduced as a balanced binary tree: leaves of kLeaf terms
+//      folded with fraction_arith (64/128-bit), a leaf switching to BigFraction only if it overflows,
+//      then neighbouring results combined pairwise, operands of about the same size
+//   4. combines the per-thread results the same way, on the same threads: after its chunk, thread t adds in
+//      the result of thread t + 1, then t + 2, t + 4, ... (while t is a multiple of twice the step), each as
+//      soon as that thread is done -- log2(threads) levels, no threads started after the first
+// Exact arithmetic is associative and commutative, and BigFraction is always canonical, so the result is
+// bit for bit the serial fold's.
+//
+// op: std::plus<> (or std::plus<Fraction>) for a sum, std::multiplies<> (or std::multiplies<Fraction>) for a product.
+
+namespace fraction_reduce_detail {
+
+constexpr std::size_t kLeaf = 32;                   // terms folded serially at the bottom of the tree
+constexpr std::size_t kMinTermsPerThread = 1 << 14;  // below this a thread costs more than it saves
+
+template <typename Op>
+constexpr bool is_plus = std::is_same_v<Op, std::plus<>> || std::is_same_v<Op, std::plus<Fraction>>;
+
+template <typename Op>
+constexpr bool is_multiplies = std::is_same_v<Op, std::multiplies<>> || std::is_same_v<Op, std::multiplies<Fraction>>;
+
+template <bool Sum>
+BigFraction combine(const BigFraction &x, const BigFraction &y) {
+    if constexpr(Sum)
+        return x + y;
+    else
+        return x * y;
+}
+
+template <bool Sum>
+BigFraction identity() {
+    return Sum ? BigFraction() : BigFraction(BigInt(1), BigInt(1));
+}
+
+inline BigFraction widen(fraction_arith::Rational64 r) {
+    return BigFraction(BigInt(r.numerator), BigInt(r.denominator));
+}
+
+// serial fold of a few terms: 64-bit while it fits, BigFraction from the first overflow on
+template <bool Sum>
+BigFraction fold_leaf(std::span<const fraction_arith::Rational64> terms) {
+    fraction_arith::Rational64 small = terms[0];
+    std::size_t i = 1;
+    for(; i < terms.size(); i++) {
+        const std::optional<fraction_arith::Rational64> r =
+            Sum ? fraction_arith::add(small, terms[i]) : fraction_arith::mul(small, terms[i]);
+        if(!r)
+            break;
+        small = *r;
+    }
+    if(i == terms.size())
+        return widen(small);
+    BigFraction big = widen(small);
+    for(; i < terms.size(); i++)
+        big = combine<Sum>(big, widen(terms[i]));
+    return big;
+}
+
+template <bool Sum>
+BigFraction reduce_tree(std::span<const fraction_arith::Rational64> terms) {
+    if(terms.size() <= kLeaf)
+        return fold_leaf<Sum>(terms);
+    const std::size_t half = terms.size() / 2;
+    return combine<Sum>(reduce_tree<Sum>(terms.first(half)), reduce_tree<Sum>(terms.subspan(half)));
+}
+
+}   // namespace fraction_reduce_detail
+
+
+// threads = 0: one per hardware thread (the caller is one of them); throws std::domain_error for a zero
+// denominator (like BigFraction), and rethrows what a thread threw (std::bad_alloc) on the caller
+template <typename Op>
+BigFraction fraction_reduce(std::span<const Fraction> terms, Op, unsigned threads = 0) {
+    using namespace fraction_reduce_detail;
+    static_assert(is_plus<Op> || is_multiplies<Op>, "fraction_reduce: op must be std::plus<> or std::multiplies<>");
+    constexpr bool kSum = is_plus<Op>;
+    if(terms.empty())
+        return identity<kSum>();
+
+    std::vector<fraction_arith::Rational64> canonical(terms.size());
+    for(std::size_t i = 0; i < terms.size(); i++) {
+        if(terms[i].get_denominator() == 0)
+            throw std::domain_error("fraction_reduce: zero denominator");
+        // an int numerator / denominator always reduces into 64 bits
+        canonical[i] = *fraction_arith::reduce(terms[i].get_numerator(), terms[i].get_denominator());
+    }
+    // a product has no lcm to keep small: only sums are regrouped
+    if constexpr(kSum) {
+        const auto by_denominator = [](const fraction_arith::Rational64 &x, const fraction_arith::Rational64 &y) {
+            return x.denominator < y.denominator;
+        };
+        if(!std::is_sorted(canonical.begin(), canonical.end(), by_denominator))
+            std::sort(canonical.begin(), canonical.end(), by_denominator);
+    }
+
+    if(threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, terms.size() / kMinTermsPerThread + 1));
+
+    const std::span<const fraction_arith::Rational64> all(canonical);
+    if(threads == 1)
+        return reduce_tree<kSum>(all);
+
+    // a chunk per thread, then the combine tree on the same threads: partial[t] ends up holding the result of
+    // threads t .. t + step - 1, where step is t's lowest set bit (all of them, for thread 0)
+    std::vector<BigFraction> partial(threads);
+    std::vector<std::exception_ptr> errors(threads);
+    std::vector<std::atomic<bool>> done(threads);
+    const auto work = [&](unsigned t) {
+        try {
+            const std::size_t begin = all.size() * t / threads;
+            const std::size_t end = all.size() * (t + 1) / threads;
+            partial[t] = reduce_tree<kSum>(all.subspan(begin, end - begin));
+            for(unsigned step = 1; t % (2 * step) == 0 && t + step < threads; step *= 2) {
+                done[t + step].wait(false, std::memory_order_acquire);
+                if(errors[t + step])
+                    break;   // nothing to combine with: the caller rethrows it
+                partial[t] = combine<kSum>(partial[t], partial[t + step]);
+            }
+        }
+        catch(...) {
+            errors[t] = std::current_exception();
+        }
+        done[t].store(true, std::memory_order_release);
+        done[t].notify_one();
+    };
+    {
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        unsigned started = 1;
+        try {
+            for(; started < threads; started++)
+                workers.emplace_back(work, started);
+        }
+        catch(const std::system_error&) {
+            // out of threads: the caller does the rest itself, highest first (t only waits for higher ones)
+            for(unsigned t = threads - 1; t >= started; t--)
+                work(t);
+        }
+        work(0);
+        for(std::thread &worker : workers)
+            worker.join();
+    }
+    for(const std::exception_ptr &error : errors) {
+        if(error)
+            std::rethrow_exception(error);
+    }
+    return std::move(partial[0]);
+}
@@ -0,0 +1,80 @@
+// build: g++ -std=c++20 -O2 -pthread fraction_reduce_use.cpp
+// usage: ./a.out [terms]        (default 100k harmonic terms)
+
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "../01_basics/timing.h"
+#include "fraction_reduce.h"
+
+BigFraction serial_sum(const std::vector<Fraction> &terms) {
+    BigFraction total;
+    for(const Fraction &f : terms)
+        total = total + f;
+    return total;
+}
+
+int main(int argc, char **argv) {
+    std::vector<Fraction> harmonic;
+    for(int k = 1; k <= 30; k++)
+        harmonic.emplace_back(1, k);
+    std::cout <<fraction_reduce(harmonic, std::plus<>{}) <<'\n';         // 9304682830147/2329089562800
+    std::cout <<(fraction_reduce(harmonic, std::plus<>{}) == serial_sum(harmonic)) <<'\n';   // 1
+
+    // (2/1) * (3/2) * ... * (1001/1000) telescopes
+    std::vector<Fraction> ratios;
+    for(int k = 1; k <= 1000; k++)
+        ratios.emplace_back(k + 1, k);
+    std::cout <<fraction_reduce(ratios, std::multiplies<>{}) <<'\n';     // 1001/1
+
+    std::cout <<fraction_reduce(std::vector<Fraction>{}, std::plus<>{}) <<' '
+              <<fraction_reduce(std::vector<Fraction>{}, std::multiplies<>{}) <<'\n';   // 0/1 1/1
+
+    // ------------------------------------------------------------
+    // Benchmark: exact sums
+    // ------------------------------------------------------------
+    const int n = argc > 1 ? std::atoi(argv[1]) : 100'000;
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+
+    harmonic.clear();
+    for(int k = 1; k <= n; k++)
+        harmonic.emplace_back(1, k);
+
+    BigFraction serial, one_thread, parallel;
+    const double serial_ms = time_ms([&] { serial = serial_sum(harmonic); });
+    const double tree_ms = time_ms([&] { one_thread = fraction_reduce(harmonic, std::plus<>{}, 1); });
+    const double parallel_ms = time_ms([&] { parallel = fraction_reduce(harmonic, std::plus<>{}); });
+
+    std::cout <<"H(" <<n <<"): denominator of " <<serial.get_denominator().bit_length() <<" bits\n";
+    std::cout <<"serial BigFraction fold:      " <<serial_ms <<" ms\n";
+    std::cout <<"fraction_reduce, 1 thread:    " <<tree_ms <<" ms, " <<serial_ms / tree_ms <<"x, same: " <<(one_thread == serial) <<'\n';
+    std::cout <<"fraction_reduce, " <<cores <<" thread(s): " <<parallel_ms <<" ms, " <<serial_ms / parallel_ms <<"x, same: " <<(parallel == serial) <<'\n';
+
+    // many terms, few distinct denominators: where the regrouping pays off
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> numerator(-1000, 1000), denominator(1, 60);
+    std::vector<Fraction> terms;
+    for(int i = 0; i < 50 * n; i++)
+        terms.emplace_back(numerator(rng), denominator(rng));
+
+    const double serial_random_ms = time_ms([&] { serial = serial_sum(terms); });
+    const double parallel_random_ms = time_ms([&] { parallel = fraction_reduce(terms, std::plus<>{}); });
+    std::cout <<terms.size() <<" random terms, denominators 1..60\n";
+    std::cout <<"serial BigFraction fold:      " <<serial_random_ms <<" ms\n";
+    std::cout <<"fraction_reduce:              " <<parallel_random_ms <<" ms, " <<serial_random_ms / parallel_random_ms
+              <<"x, same: " <<(parallel == serial) <<'\n';
+
+    // measured (-O2, a 1-core VM, so the threads can't show here):
+    //   H(100000), 144k-bit denominator:  serial ~4800 ms, fraction_reduce ~300 ms (~15x; ~440 ms with
+    //                                     schoolbook multiply and Lehmer gcd only)
+    //   H(20000):                         serial ~215 ms,  fraction_reduce ~43 ms  (~5x)
+    //   5M random terms, denominators 1..60: serial ~5400 ms, fraction_reduce ~890 ms (~6x)
+    // the gap grows with n: the serial fold is ~n^2, the balanced tree ~M(result size) * log n.
+    // Across threads the leaves scale; the last few combines of huge operands don't: each is one serial
+    // multiply and gcd (Karatsuba and half-gcd at these sizes, ~n^1.6), so H(100M) would be bounded by its top level.
+
+    return 0;
+}
@@ -0,0 +1,125 @@
+// sorting fraction arrays by value: LSD radix sort on a double key, exact fix-up of ties
+// same result as std::stable_sort with Fraction's operator<
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "fraction.h"
+
+// std::sort(begin, end) with operator< is a comparison sort: ~n log2 n comparisons,
+// each one two 128-bit multiplies and an unpredictable branch (10M elements: ~230M of them).
+//
+// sort_fractions:
+//   1. key = numerator / denominator as a double, bits flipped so that unsigned integer order
+//      is double order (the usual trick: negative -> invert all bits, positive -> set the sign bit)
+//   2. each element becomes ONE uint64: the top bits of its key, and its index in the low bits
+//        [ key (64 - index_bits) | index (index_bits) ]          10M elements: 40 key bits, 24 index bits
+//      8 bytes per element instead of 16: every pass moves half the memory
+//   3. LSD radix sort on the key bits, 11 bits per pass (4 passes for 10M): a fixed number of
+//      sequential passes, no comparisons, no branches to mispredict. Passes where every key
+//      has the same digit (e.g. the exponent bits of values in a narrow range) are skipped.
+//      Then the fractions are gathered in that order by index.
+//   4. Exactness: IEEE division is correctly rounded, and rounding is monotonic,
+//      so a/b < c/d  =>  key(a/b) <= key(c/d), and truncating the keys keeps that true.
+//      The radix order can only be wrong INSIDE a run of equal keys (fractions closer together than
+//      the kept key bits can tell apart, or equal values like 1/2 and 2/4): every such run is re-sorted
+//      with the exact operator<. With 40 key bits the runs are rare and tiny.
+//
+// Stable: equivalent fractions (1/2, 2/4) keep their input order, like std::stable_sort
+// (ties in the key are ordered by index, and the run fix-up is a stable sort).
+
+namespace fraction_sort_detail {
+
+inline std::uint64_t sort_key(int numerator, int denominator) {
+    // + 0.0 turns -0.0 (0/-5) into +0.0, so every zero gets the same key
+    const double value = static_cast<double>(numerator) / static_cast<double>(denominator) + 0.0;
+    const std::uint64_t bits = std::bit_cast<std::uint64_t>(value);
+    return (bits >> 63) != 0 ? ~bits : bits | (std::uint64_t{1} << 63);
+}
+
+constexpr unsigned kDigitBits = 11;
+constexpr std::size_t kBuckets = std::size_t{1} << kDigitBits;
+
+// stable; insertion sort for the usual 2-3 element run
+inline void sort_run(std::span<Fraction> run) {
+    if(run.size() > 16) {
+        std::stable_sort(run.begin(), run.end(), std::less<>{});
+        return;
+    }
+    for(std::size_t i = 1; i < run.size(); i++) {
+        const Fraction value = run[i];
+        std::size_t j = i;
+        for(; j > 0 && value < run[j - 1]; j--)
+            run[j] = run[j - 1];
+        run[j] = value;
+    }
+}
+
+}   // namespace fraction_sort_detail
+
+
+inline void sort_fractions(std::span<Fraction> fractions) {
+    using namespace fraction_sort_detail;
+    const std::size_t n = fractions.size();
+    if(n < 256 || n > UINT32_MAX) {   // radix passes don't pay off for small arrays
+        std::stable_sort(fractions.begin(), fractions.end(), std::less<>{});
+        return;
+    }
+
+    const unsigned index_bits = static_cast<unsigned>(std::bit_width(n - 1));
+    const std::uint64_t index_mask = (std::uint64_t{1} << index_bits) - 1;
+    const unsigned passes = (64 - index_bits + kDigitBits - 1) / kDigitBits;
+
+    std::vector<std::uint64_t> items(n);
+    std::vector<std::uint64_t> buffer(n);
+    // one read pass builds every pass's histogram at once
+    std::vector<std::size_t> counts(passes * kBuckets, 0);
+    for(std::size_t i = 0; i < n; i++) {
+        const std::uint64_t key = sort_key(fractions[i].get_numerator(), fractions[i].get_denominator());
+        const std::uint64_t item = (key & ~index_mask) | i;
+        items[i] = item;
+        for(unsigned pass = 0; pass < passes; pass++)
+            counts[pass * kBuckets + ((item >> (index_bits + pass * kDigitBits)) & (kBuckets - 1))]++;
+    }
+
+    for(unsigned pass = 0; pass < passes; pass++) {
+        std::size_t *count = counts.data() + pass * kBuckets;
+        const unsigned shift = index_bits + pass * kDigitBits;
+        if(count[(items[0] >> shift) & (kBuckets - 1)] == n)
+            continue;   // every key has the same digit here: the pass wouldn't move anything
+
+        // counts -> starting offsets
+        std::size_t offset = 0;
+        for(std::size_t b = 0; b < kBuckets; b++) {
+            const std::size_t c = count[b];
+            count[b] = offset;
+            offset += c;
+        }
+        for(const std::uint64_t item : items)
+            buffer[count[(item >> shift) & (kBuckets - 1)]++] = item;
+        items.swap(buffer);
+    }
+
+    // gather in sorted order
+    const std::vector<Fraction> original(fractions.begin(), fractions.end());
+    for(std::size_t i = 0; i < n; i++)
+        fractions[i] = original[items[i] & index_mask];
+
+    // exact fix-up of runs with equal (truncated) keys
+    for(std::size_t start = 0; start < n;) {
+        const std::uint64_t key = items[start] & ~index_mask;
+        std::size_t end = start + 1;
+        while(end < n && (items[end] & ~index_mask) == key)
+            end++;
+        if(end - start > 1)
+            sort_run(fractions.subspan(start, end - start));
+        start = end;
+    }
+}
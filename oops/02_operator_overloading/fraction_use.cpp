@@ -1,4 +1,6 @@
-#include"fraction.h"
+#include <iostream>
+
+#include "fraction.h"
 
 int main() {
     Fraction f(1, 4);
@@ -0,0 +1,220 @@
+// gcd kernels for Fraction: branch-light binary (Stein's) gcd + batched SIMD (AVX2) reduction
+// compile with -mavx2 (or -march=native) to get the vector path, otherwise the scalar fallback is used
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// std::gcd is Euclid's algorithm: a loop of integer DIVISIONS (a % b),
+// and a 32/64-bit divide costs ~20-40+ cycles with a data-dependent branch per step.
+//
+// Binary gcd (Stein's algorithm) uses only shifts, subtractions and comparisons:
+//   gcd(u, v) with both even  = 2 * gcd(u/2, v/2)   -> factor out common twos once: shift = ctz(u | v)
+//   gcd(u, v) with one even   = gcd(odd one, even one / 2^k)
+//   gcd(u, v) with both odd   = gcd(min, max - min)  (max - min is even: strip its twos next round)
+// __builtin_ctz (count trailing zeros) strips ALL the twos in one instruction (tzcnt/bsf),
+// and min/max compile to cmov: the loop body has no unpredictable branches.
+//
+// SIMD: the same steps work lane-wise on 8 x 32-bit values in an AVX2 register.
+//   - there is no vector ctz, but x & -x isolates the lowest set bit (a power of two);
+//     converting that to float puts log2 of it in the exponent field: ctz for free
+//   - _mm256_srlv_epi32 shifts each lane by its own count
+//   - lanes that finish early are masked off until every lane is done
+
+namespace gcd_kernel {
+
+constexpr std::uint32_t binary_gcd(std::uint32_t u, std::uint32_t v) {
+    if(u == 0)
+        return v;
+    if(v == 0)
+        return u;
+    const int shift = __builtin_ctz(u | v);
+    u >>= __builtin_ctz(u);
+    while(v != 0) {
+        v >>= __builtin_ctz(v);
+        const std::uint32_t low = u < v ? u : v;    // cmov
+        const std::uint32_t high = u < v ? v : u;
+        u = low;
+        v = high - low;
+    }
+    return u << shift;
+}
+
+constexpr std::uint64_t binary_gcd(std::uint64_t u, std::uint64_t v) {
+    if(u == 0)
+        return v;
+    if(v == 0)
+        return u;
+    const int shift = __builtin_ctzll(u | v);
+    u >>= __builtin_ctzll(u);
+    while(v != 0) {
+        v >>= __builtin_ctzll(v);
+        const std::uint64_t low = u < v ? u : v;
+        const std::uint64_t high = u < v ? v : u;
+        u = low;
+        v = high - low;
+    }
+    return u << shift;
+}
+
+constexpr std::uint32_t magnitude(std::int32_t v) {
+    return v < 0 ? 0u - static_cast<std::uint32_t>(v) : static_cast<std::uint32_t>(v);
+}
+
+// scalar: one fraction to lowest terms with a positive denominator (precondition: denominator != 0)
+// worked in 64 bits: INT_MIN/-1 is 2^31/1 and 1/INT_MIN is -1/2^31, neither fits back -> std::overflow_error
+constexpr void reduce_one(std::int32_t &numerator, std::int32_t &denominator) {
+    std::int64_t n = numerator;
+    std::int64_t d = denominator;
+    const std::int64_t g = binary_gcd(magnitude(numerator), magnitude(denominator));   // up to 2^31
+    if(g > 1) {
+        n /= g;
+        d /= g;
+    }
+    if(d < 0) {
+        n = -n;
+        d = -d;
+    }
+    if(n > INT32_MAX || d > INT32_MAX)
+        throw std::overflow_error("gcd_kernel: lowest terms don't fit in int32");
+    numerator = static_cast<std::int32_t>(n);
+    denominator = static_cast<std::int32_t>(d);
+}
+
+inline void gcd_batch_scalar(const std::int32_t *a, const std::int32_t *b, std::uint32_t *out, std::size_t n) {
+    for(std::size_t i = 0; i < n; i++)
+        out[i] = binary_gcd(magnitude(a[i]), magnitude(b[i]));
+}
+
+inline void reduce_batch_scalar(std::int32_t *numerators, std::int32_t *denominators, std::size_t n) {
+    for(std::size_t i = 0; i < n; i++)
+        reduce_one(numerators[i], denominators[i]);
+}
+
+
+#if defined(__AVX2__)
+
+// count trailing zeros of each lane (x != 0): exponent of float(x & -x)
+inline __m256i ctz_epi32(__m256i x) {
+    const __m256i lowest_bit = _mm256_and_si256(x, _mm256_sub_epi32(_mm256_setzero_si256(), x));
+    // 2^31 converts as -2^31: the sign bit is set but the exponent (31) is still right
+    const __m256i bits = _mm256_castps_si256(_mm256_cvtepi32_ps(lowest_bit));
+    const __m256i exponent = _mm256_and_si256(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(0xFF));
+    return _mm256_sub_epi32(exponent, _mm256_set1_epi32(127));
+}
+
+// 8 gcds at once, inputs already non-negative (as unsigned lanes)
+inline __m256i gcd_epu32(__m256i u, __m256i v) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i u_zero = _mm256_cmpeq_epi32(u, zero);
+    const __m256i v_zero = _mm256_cmpeq_epi32(v, zero);
+    const __m256i u_in = u;
+    const __m256i v_in = v;
+
+    // gcd(0, x) = x: run zero lanes on (1, 1) and patch the answer in at the end
+    const __m256i any_zero = _mm256_or_si256(u_zero, v_zero);
+    u = _mm256_blendv_epi8(u, one, any_zero);
+    v = _mm256_blendv_epi8(v, one, any_zero);
+
+    const __m256i shift = ctz_epi32(_mm256_or_si256(u, v));
+    u = _mm256_srlv_epi32(u, ctz_epi32(u));
+
+    __m256i active = _mm256_cmpeq_epi32(zero, zero);   // all ones: every lane still has v != 0
+    while(!_mm256_testz_si256(active, active)) {
+        // ctz of a 0 lane comes out negative -> srlv by a huge count -> 0 stays 0
+        v = _mm256_srlv_epi32(v, ctz_epi32(v));
+        const __m256i low = _mm256_min_epu32(u, v);
+        const __m256i high = _mm256_max_epu32(u, v);
+        u = _mm256_blendv_epi8(u, low, active);
+        v = _mm256_blendv_epi8(v, _mm256_sub_epi32(high, low), active);
+        active = _mm256_andnot_si256(_mm256_cmpeq_epi32(v, zero), active);
+    }
+    __m256i g = _mm256_sllv_epi32(u, shift);
+
+    g = _mm256_blendv_epi8(g, v_in, u_zero);           // gcd(0, v) = v
+    g = _mm256_blendv_epi8(g, u_in, v_zero);           // gcd(u, 0) = u   (and gcd(0, 0) = 0)
+    return g;
+}
+
+inline void gcd_batch_avx2(const std::int32_t *a, const std::int32_t *b, std::uint32_t *out, std::size_t n) {
+    std::size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+        const __m256i u = _mm256_abs_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i)));
+        const __m256i v = _mm256_abs_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), gcd_epu32(u, v));
+    }
+    gcd_batch_scalar(a + i, b + i, out + i, n - i);   // tail
+}
+
+// exact division n / g for 4 lanes through double: both are exact in a double and the true
+// quotient is an integer, so the correctly-rounded IEEE division IS that integer
+// (there is no integer divide instruction in AVX2)
+inline __m128i divide_exact_epi32(__m128i n, __m128i g) {
+    const __m256d q = _mm256_div_pd(_mm256_cvtepi32_pd(n), _mm256_cvtepi32_pd(g));
+    return _mm256_cvttpd_epi32(q);
+}
+
+inline void reduce_batch_avx2(std::int32_t *numerators, std::int32_t *denominators, std::size_t n) {
+    std::size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+        __m256i num = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(numerators + i));
+        __m256i den = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(denominators + i));
+        __m256i g = gcd_epu32(_mm256_abs_epi32(num), _mm256_abs_epi32(den));
+        // g = 0 only for 0/0: divide by 1 instead (leaves 0/0 as is, like the scalar path)
+        g = _mm256_blendv_epi8(g, _mm256_set1_epi32(1), _mm256_cmpeq_epi32(g, _mm256_setzero_si256()));
+
+        const __m128i num_low = divide_exact_epi32(_mm256_castsi256_si128(num), _mm256_castsi256_si128(g));
+        const __m128i num_high = divide_exact_epi32(_mm256_extracti128_si256(num, 1), _mm256_extracti128_si256(g, 1));
+        const __m128i den_low = divide_exact_epi32(_mm256_castsi256_si128(den), _mm256_castsi256_si128(g));
+        const __m128i den_high = divide_exact_epi32(_mm256_extracti128_si256(den, 1), _mm256_extracti128_si256(g, 1));
+        num = _mm256_set_m128i(num_high, num_low);
+        den = _mm256_set_m128i(den_high, den_low);
+
+        // the lanes reduce_one throws for: INT_MIN over a negative denominator, or an odd numerator over INT_MIN
+        const __m256i int_min = _mm256_set1_epi32(INT32_MIN);
+        const __m256i unfit = _mm256_or_si256(
+            _mm256_and_si256(_mm256_cmpeq_epi32(num, int_min), _mm256_cmpgt_epi32(_mm256_setzero_si256(), den)),
+            _mm256_cmpeq_epi32(den, int_min));
+        if(!_mm256_testz_si256(unfit, unfit))
+            throw std::overflow_error("gcd_kernel: lowest terms don't fit in int32");
+
+        // positive denominators: _mm256_sign_epi32(x, den) negates x where den < 0
+        num = _mm256_sign_epi32(num, den);
+        den = _mm256_abs_epi32(den);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(numerators + i), num);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(denominators + i), den);
+    }
+    reduce_batch_scalar(numerators + i, denominators + i, n - i);
+}
+
+#endif
+
+
+// out[i] = gcd(|a[i]|, |b[i]|)
+inline void gcd_batch(const std::int32_t *a, const std::int32_t *b, std::uint32_t *out, std::size_t n) {
+#if defined(__AVX2__)
+    gcd_batch_avx2(a, b, out, n);
+#else
+    gcd_batch_scalar(a, b, out, n);
+#endif
+}
+
+// every numerators[i] / denominators[i] to lowest terms with a positive denominator
+// (std::overflow_error if one doesn't fit: see reduce_one; the block may then be partly reduced)
+inline void reduce_batch(std::int32_t *numerators, std::int32_t *denominators, std::size_t n) {
+#if defined(__AVX2__)
+    reduce_batch_avx2(numerators, denominators, n);
+#else
+    reduce_batch_scalar(numerators, denominators, n);
+#endif
+}
+
+}   // namespace gcd_kernel
@@ -0,0 +1,82 @@
+// build: g++ -std=c++20 -O2 -mavx2 gcd_kernel_use.cpp     (vector path)
+//        g++ -std=c++20 -O2 gcd_kernel_use.cpp            (scalar fallback)
+
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "../01_basics/timing.h"
+#include "fraction.h"
+
+constexpr std::size_t kPairs = 4'000'000;
+
+int main() {
+    std::cout <<gcd_kernel::binary_gcd(48u, 180u) <<'\n';   // 12
+
+    std::vector<Fraction> fractions{Fraction(6, 8), Fraction(10, -4), Fraction(0, 5), Fraction(7, 7)};
+    simplify_all(fractions);
+    for(const Fraction &f : fractions)
+        std::cout <<f <<' ';
+    std::cout <<'\n';                                        // 3/4 -5/2 0/1 1/1
+
+#if defined(__AVX2__)
+    std::cout <<"AVX2 kernel\n";
+#else
+    std::cout <<"scalar kernel\n";
+#endif
+
+    // random pairs with shared factors (like unreduced arithmetic results), some signs and zeros
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> value(-(1 << 20), 1 << 20);
+    std::uniform_int_distribution<int> factor(1, 1 << 10);
+    std::vector<std::int32_t> a(kPairs), b(kPairs);
+    for(std::size_t i = 0; i < kPairs; i++) {
+        const int f = factor(rng);
+        a[i] = i % 97 == 0 ? 0 : value(rng) % 2048 * f;
+        b[i] = value(rng) % 2048 * f;
+    }
+
+    std::vector<std::uint32_t> expected(kPairs), got(kPairs);
+    const double std_ms = time_ms([&] {
+        for(std::size_t i = 0; i < kPairs; i++)
+            expected[i] = static_cast<std::uint32_t>(std::gcd(a[i], b[i]));
+    });
+    const double binary_ms = time_ms([&] {
+        gcd_kernel::gcd_batch_scalar(a.data(), b.data(), got.data(), kPairs);
+    });
+    const bool binary_ok = got == expected;
+    const double batch_ms = time_ms([&] {
+        gcd_kernel::gcd_batch(a.data(), b.data(), got.data(), kPairs);
+    });
+    const bool batch_ok = got == expected;
+
+    std::cout <<kPairs <<" gcds\n";
+    std::cout <<"std::gcd:            " <<std_ms <<" ms\n";
+    std::cout <<"binary_gcd (scalar): " <<binary_ms <<" ms, matches std::gcd: " <<binary_ok <<'\n';
+    std::cout <<"gcd_batch:           " <<batch_ms <<" ms, matches std::gcd: " <<batch_ok <<'\n';
+
+    // whole-fraction reduction: gcd + two divisions + sign fix per fraction
+    std::vector<Fraction> many, reference;
+    for(std::size_t i = 0; i < kPairs; i++)
+        many.emplace_back(a[i], b[i] == 0 ? 1 : b[i]);
+    reference = many;
+    const double loop_ms = time_ms([&] {
+        for(Fraction &f : reference) {
+            const int g = std::gcd(f.get_numerator(), f.get_denominator());
+            const int sign = f.get_denominator() < 0 ? -1 : 1;
+            f = Fraction(sign * f.get_numerator() / g, sign * f.get_denominator() / g);
+        }
+    });
+    const double all_ms = time_ms([&] {
+        simplify_all(many);
+    });
+    bool same = true;
+    for(std::size_t i = 0; i < kPairs; i++)
+        same = same && many[i].get_numerator() == reference[i].get_numerator()
+                    && many[i].get_denominator() == reference[i].get_denominator();
+    std::cout <<"std::gcd reduce loop: " <<loop_ms <<" ms\n";
+    std::cout <<"simplify_all:         " <<all_ms <<" ms, same results: " <<same <<'\n';
+
+    return 0;
+}
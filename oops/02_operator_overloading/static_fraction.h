@@ -0,0 +1,103 @@
+// compile-time rationals: StaticFraction<N, D> is reduced by the compiler and converts to a runtime Fraction
+// like std::ratio, but with Fraction's checked arithmetic
+
+#pragma once
+
+#include <climits>
+#include <optional>
+
+#include "fraction.h"
+#include "fraction_arithmetic.h"
+
+// A StaticFraction is an empty type: the value IS the type.
+//   StaticFraction<6, 8>::numerator == 3, ::denominator == 4    (computed by the compiler)
+//   StaticFraction<6, 8>::type is StaticFraction<3, 4>          (the canonical type)
+//   StaticFraction<6, 8>::value is the constexpr Fraction 3/4
+//
+// Arithmetic between StaticFractions happens at compile time and gives another StaticFraction;
+// an overflow is a compile error (static_assert), never a runtime exception.
+//   StaticFraction<1, 6>{} + StaticFraction<1, 10>{}   is   StaticFraction<4, 15>{}
+//
+// It converts implicitly to Fraction, so it can be used anywhere a Fraction is expected:
+//   Fraction price = ...;   price * StaticFraction<108, 100>{}      (runtime result, a Fraction)
+//
+// For tables of constants, a constexpr Fraction (or std::array of them) is often simpler;
+// StaticFraction is for when the value should be part of a type (template parameters, tag types).
+
+namespace static_fraction_detail {
+
+// lowest terms, positive denominator (reduce() can't fail for int inputs: they fit in 64 bits)
+constexpr fraction_arith::Rational64 canonical(long long numerator, long long denominator) {
+    return *fraction_arith::reduce(numerator, denominator);
+}
+
+constexpr bool fits_int(std::optional<fraction_arith::Rational64> r) {
+    return r && r->numerator >= INT_MIN && r->numerator <= INT_MAX && r->denominator <= INT_MAX;
+}
+
+}   // namespace static_fraction_detail
+
+
+template <int N, int D>
+struct StaticFraction {
+    static_assert(D != 0, "StaticFraction: zero denominator");
+
+private:
+    static constexpr fraction_arith::Rational64 kCanonical = static_fraction_detail::canonical(N, D);
+    static_assert(static_fraction_detail::fits_int(kCanonical), "StaticFraction: value doesn't fit in int");   // INT_MIN / -1
+
+public:
+    static constexpr int numerator = static_cast<int>(kCanonical.numerator);
+    static constexpr int denominator = static_cast<int>(kCanonical.denominator);
+
+    using type = StaticFraction<numerator, denominator>;
+
+    static constexpr Fraction value{numerator, denominator};
+
+    constexpr operator Fraction() const {
+        return value;
+    }
+};
+
+
+// StaticFraction op StaticFraction: evaluated by the compiler, the result is a type
+
+template <int A, int B, int C, int D>
+constexpr auto operator+(StaticFraction<A, B>, StaticFraction<C, D>) {
+    constexpr std::optional<fraction_arith::Rational64> r = fraction_arith::add(
+        fraction_arith::Rational64{StaticFraction<A, B>::numerator, StaticFraction<A, B>::denominator},
+        fraction_arith::Rational64{StaticFraction<C, D>::numerator, StaticFraction<C, D>::denominator});
+    static_assert(static_fraction_detail::fits_int(r), "StaticFraction overflow in operator+");
+    return StaticFraction<static_cast<int>(r->numerator), static_cast<int>(r->denominator)>{};
+}
+
+template <int A, int B, int C, int D>
+constexpr auto operator*(StaticFraction<A, B>, StaticFraction<C, D>) {
+    constexpr std::optional<fraction_arith::Rational64> r = fraction_arith::mul(
+        fraction_arith::Rational64{StaticFraction<A, B>::numerator, StaticFraction<A, B>::denominator},
+        fraction_arith::Rational64{StaticFraction<C, D>::numerator, StaticFraction<C, D>::denominator});
+    static_assert(static_fraction_detail::fits_int(r), "StaticFraction overflow in operator*");
+    return StaticFraction<static_cast<int>(r->numerator), static_cast<int>(r->denominator)>{};
+}
+
+template <int A, int B, int C, int D>
+constexpr bool operator==(StaticFraction<A, B>, StaticFraction<C, D>) {
+    // both canonical: equal values have equal numerators and denominators
+    return StaticFraction<A, B>::numerator == StaticFraction<C, D>::numerator
+        && StaticFraction<A, B>::denominator == StaticFraction<C, D>::denominator;
+}
+
+
+// StaticFraction op Fraction: a runtime Fraction
+// (Fraction op StaticFraction already works: Fraction's member operators convert the argument,
+//  and == is found in both orders in C++20)
+
+template <int N, int D>
+constexpr Fraction operator+(StaticFraction<N, D>, Fraction const &f) {
+    return StaticFraction<N, D>::value + f;
+}
+
+template <int N, int D>
+constexpr Fraction operator*(StaticFraction<N, D>, Fraction const &f) {
+    return StaticFraction<N, D>::value * f;
+}
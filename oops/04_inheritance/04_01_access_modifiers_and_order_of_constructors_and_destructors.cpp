@@ -2,9 +2,15 @@
 #include <string>
 using namespace std;
 
+#include "lifecycle_trace.h"
+
 // Before the creation of an object of a child class, its parent class constructor runs first.
 // Constructors run from base → derived.
 // Destructors run in the reverse order (derived → base).
+//
+// Each constructor / destructor records an event (lifecycle_trace.h) instead of printing:
+// cout << ... << endl flushes, a syscall per event -- too slow to leave in real code.
+// main prints the recorded order at the end.
 
 class Vehicle {
     private :
@@ -20,14 +26,14 @@ class Vehicle {
     // Most well-designed base classes still keep data private, use protected methods occasionallt & protected members rarely
 
     Vehicle(int z) {
-        cout << "Vehicle's Parametrized constructor" << endl;
+        trace_constructed(this, "Vehicle");
         maxSpeed = z;
         numTyres = 4;
         color = "Black";
     }
 
     ~Vehicle() {
-        cout << "Vehicle's Destructor" << endl;
+        trace_destroyed(this, "Vehicle");
     }
 
     int get_max_speed() const {   // controlled access to private data
@@ -44,12 +50,12 @@ class Car : public Vehicle {
         // Without this, the compiler would try to call Vehicle's default constructor.
         // Since it doesn't exist, compilation would fail.
         Car(int x, int y) : Vehicle(x) {
-            cout << "Car's constructor" << endl;
+            trace_constructed(this, "Car");
             numGears = y;
         }
 
         ~Car() {
-            cout << "Car's Destructor" << endl;
+            trace_destroyed(this, "Car");
         }
 
         void print() {
@@ -66,11 +72,11 @@ class Tesla : public Car {
     public :
 
         Tesla(int x, int y) : Car(x, y) {
-            cout << "Tesla's constructor" << endl;
+            trace_constructed(this, "Tesla");
         }
 
         ~Tesla() {
-            cout << "Tesla's destructor" << endl;
+            trace_destroyed(this, "Tesla");
         }
 };
 
@@ -89,18 +95,24 @@ class Tesla : public Car {
 
 
 int main() {
-    Tesla t(200, 6);
-    // Vehicle's Parametrized constructor
-    // Car's constructor
-    // Tesla's constructor
-
-    t.print();
-    // NumTyres : 4
-    // Color : Black
-    // Num gears : 6
-    // Max Speed : 200
-
-    // Tesla's destructor
-    // Car's Destructor
-    // Vehicle's Destructor
-}
\ No newline at end of file
+    lifecycle_trace_enable();
+
+    {
+        Tesla t(200, 6);
+
+        t.print();
+        // NumTyres : 4
+        // Color : Black
+        // Num gears : 6
+        // Max Speed : 200
+    }
+
+    cout << "\n--- constructors and destructors, in the order they ran ---\n";
+    print_lifecycle_trace(cout, collect_lifecycle_trace());
+    //      0.000 us  thread 0  construct Vehicle    +0
+    //      0.269 us  thread 0  construct Car        +0
+    //      0.337 us  thread 0  construct Tesla      +0      (one object: every layer at the same address)
+    //     61.711 us  thread 0  destroy   Tesla      +0      (after print(): its endl's are the slow part)
+    //     61.763 us  thread 0  destroy   Car        +0
+    //     61.812 us  thread 0  destroy   Vehicle    +0
+}
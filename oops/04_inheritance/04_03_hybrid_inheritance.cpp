@@ -33,6 +33,9 @@
 #include <string>
 using namespace std;
 
+// constructors / destructors record events instead of printing: see the trace at the end of main
+#include "lifecycle_trace.h"
+
 class Vehicle {
 private:
     int maxSpeed;
@@ -48,7 +51,7 @@ public:
     }
 
     Vehicle(int z) : maxSpeed(z), numTyres(0) {
-        cout << "Vehicle constructor, maxSpeed = " << z << endl;
+        trace_constructed(this, "Vehicle");
     }
 
     int max_speed() const {
@@ -56,7 +59,7 @@ public:
     }
 
     ~Vehicle() {
-        cout << "Vehicle destructor" << endl;
+        trace_destroyed(this, "Vehicle");
     }
 };
 
@@ -68,12 +71,12 @@ public:
     // In non-virtual inheritance, Car is responsible for
     // constructing its own Vehicle subobject.
     Car() : Vehicle(3), numGears(5) {
-        cout << "Car constructor" << endl;
+        trace_constructed(this, "Car");
         numTyres = 4;
     }
 
     ~Car() {
-        cout << "Car destructor" << endl;
+        trace_destroyed(this, "Car");
     }
 
     void print() {
@@ -88,27 +91,28 @@ public:
 class Truck : public Vehicle {
 public:
     Truck() : Vehicle(4) {
-        cout << "Truck constructor" << endl;
+        trace_constructed(this, "Truck");
         numTyres = 6;
     }
 
     ~Truck() {
-        cout << "Truck destructor" << endl;
+        trace_destroyed(this, "Truck");
     }
 };
 
 class Bus : public Car, public Truck {
 public:
     Bus() {
-        cout << "Bus constructor" << endl;
+        trace_constructed(this, "Bus");
     }
 
     ~Bus() {
-        cout << "Bus destructor" << endl;
+        trace_destroyed(this, "Bus");
     }
 };
 
 int main() {
+    lifecycle_trace_enable();
 
     // --------------------------------------------------------
     // CONSTRUCTION ORDER (important interview topic)
@@ -127,60 +131,75 @@ int main() {
     // Bus
     // --------------------------------------------------------
 
-    Bus b;
-
-    cout << "\n--- Calling Car version of print ---\n";
-    b.Car::print();
-
-    // --------------------------------------------------------
-    // AMBIGUITY EXAMPLE
-    //
-    // Bus has TWO Vehicle objects.
-    //
-    // So this is ambiguous:
-    //
-    // b.print_vehicle();  // ERROR
-    //
-    // Compiler doesn't know which path:
-    // Bus -> Car -> Vehicle
-    // Bus -> Truck -> Vehicle
-    //
-    // Fix:
-    // --------------------------------------------------------
-
-    b.Car::print_vehicle();
-    b.Truck::print_vehicle();
-
-    // --------------------------------------------------------
-    // Ambiguity also applies to data members
-    // --------------------------------------------------------
-
-    b.Car::color = "Red";
-    b.Truck::color = "Blue";
-
-    cout << "\nCar Vehicle color: " << b.Car::color << endl;
-    cout << "Truck Vehicle color: " << b.Truck::color << endl;
+    {
+        Bus b;
+
+        cout << "\n--- Calling Car version of print ---\n";
+        b.Car::print();
+
+        // --------------------------------------------------------
+        // AMBIGUITY EXAMPLE
+        //
+        // Bus has TWO Vehicle objects.
+        //
+        // So this is ambiguous:
+        //
+        // b.print_vehicle();  // ERROR
+        //
+        // Compiler doesn't know which path:
+        // Bus -> Car -> Vehicle
+        // Bus -> Truck -> Vehicle
+        //
+        // Fix:
+        // --------------------------------------------------------
+
+        b.Car::print_vehicle();
+        b.Truck::print_vehicle();
+
+        // --------------------------------------------------------
+        // Ambiguity also applies to data members
+        // --------------------------------------------------------
+
+        b.Car::color = "Red";
+        b.Truck::color = "Blue";
+
+        cout << "\nCar Vehicle color: " << b.Car::color << endl;
+        cout << "Truck Vehicle color: " << b.Truck::color << endl;
+
+        // --------------------------------------------------------
+        // OBJECT LAYOUT (conceptual)
+        //
+        // Memory roughly looks like:
+        //
+        // [Car part]
+        //   Vehicle
+        //   Car fields
+        //
+        // [Truck part]
+        //   Vehicle
+        //   Truck fields
+        //
+        // Bus fields
+        //
+        // TWO complete Vehicle objects exist.
+        //
+        // This wastes memory and causes ambiguity.
+        // That is why virtual inheritance exists.
+        // --------------------------------------------------------
+    }
 
-    // --------------------------------------------------------
-    // OBJECT LAYOUT (conceptual)
-    //
-    // Memory roughly looks like:
-    //
-    // [Car part]
-    //   Vehicle
-    //   Car fields
-    //
-    // [Truck part]
-    //   Vehicle
-    //   Truck fields
-    //
-    // Bus fields
-    //
-    // TWO complete Vehicle objects exist.
-    //
-    // This wastes memory and causes ambiguity.
-    // That is why virtual inheritance exists.
-    // --------------------------------------------------------
+    cout << "\n--- constructors and destructors, in the order they ran ---\n";
+    print_lifecycle_trace(cout, collect_lifecycle_trace());
+    //      0.000 us  thread 0  construct Vehicle    +0     <- Car's Vehicle
+    //      0.147 us  thread 0  construct Car        +0
+    //      0.212 us  thread 0  construct Vehicle    +48    <- Truck's Vehicle: a second one, at another address
+    //      0.250 us  thread 0  construct Truck      +48
+    //      0.289 us  thread 0  construct Bus        +0
+    //     35.186 us  thread 0  destroy   Bus        +0
+    //     35.229 us  thread 0  destroy   Truck      +48
+    //     35.269 us  thread 0  destroy   Vehicle    +48
+    //     35.320 us  thread 0  destroy   Car        +0
+    //     35.357 us  thread 0  destroy   Vehicle    +0
 
     return 0;
 }
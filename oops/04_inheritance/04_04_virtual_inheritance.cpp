@@ -31,6 +31,9 @@
 #include <string>
 using namespace std;
 
+// constructors / destructors record events instead of printing: see the trace at the end of main
+#include "lifecycle_trace.h"
+
 class Vehicle {
 private:
     int maxSpeed;
@@ -42,7 +45,8 @@ public:
     string color;
 
     Vehicle(int z) : maxSpeed(z), numTyres(0) {
-        cout << "Vehicle constructor, maxSpeed = " << z << endl;
+        trace_constructed(this, "Vehicle");
+        cout << "Vehicle constructor, maxSpeed = " << z << endl;   // z tells which class constructed it
     }
 
     int max_speed() const {
@@ -67,7 +71,7 @@ public:
     // (i.e., deleted via base pointer), its destructor MUST be virtual.
     // Presence of any other virtual function is a strong hint you need this.
     ~Vehicle() {
-        cout << "Vehicle destructor" << endl;
+        trace_destroyed(this, "Vehicle");
     }
     // General rule: If a class has any virtual function, give it a virtual destructor. If it has no virtual functions, don't.
     // since the class doesn't have any virtual methods, its unlikely to be used like: Vehicle* v = new Bus()
@@ -85,19 +89,19 @@ public:
     //
     // The most derived class constructs the virtual base.
     Car() : Vehicle(3), numGears(5) {
-        cout << "Car constructor" << endl;
+        trace_constructed(this, "Car");
         numTyres = 4;
     }
 
     ~Car() {
-        cout << "Car destructor" << endl;
+        trace_destroyed(this, "Car");
     }
 };
 
 class Truck : virtual public Vehicle {
 public:
     Truck() : Vehicle(4) {
-        cout << "Truck constructor" << endl;
+        trace_constructed(this, "Truck");
         numTyres = 8;
     }
 
@@ -106,7 +110,7 @@ public:
     }
 
     ~Truck() {
-        cout << "Truck destructor" << endl;
+        trace_destroyed(this, "Truck");
     }
 };
 
@@ -120,64 +124,71 @@ public:
     // Vehicle has a default constructor.
     // unlike in case of hybrid inheritance, where Bus didn't need to (& couldn't) construct a Vehicle
     Bus() : Vehicle(5) {
-        cout << "Bus constructor" << endl;
+        trace_constructed(this, "Bus");
     }
 
     ~Bus() {
-        cout << "Bus destructor" << endl;
+        trace_destroyed(this, "Bus");
     }
 };
 
 int main() {
+    lifecycle_trace_enable();
+
+    {
+        cout << "---- Bus object ----\n";
+        Bus b;
+        // ---- Bus object ----
+        // Vehicle constructor, maxSpeed = 5    <- Bus's Vehicle(5): not Car's 3, not Truck's 4
+        b.print_speed();
+        // Truck sees max speed = 5
+
+        // No ambiguity anymore
+        b.color = "Yellow";
+
+        cout << "Shared Vehicle color = " << b.color << endl;
+        // Shared Vehicle color = Yellow
+
+        // Only ONE Vehicle exists
+
+
+        // Note:
+        // 1.
+        // If bus was only inheriting from only one class, say Truck
+        // which was still inheriting: class Truck : virtual public Vehicle
+        // then the vehicle constructor would be calles by Bus, not Truck
+        // The most derived class always initializes virtual bases — even if only one path exists.
+
+        // 2.
+        // If bus was still inheriting from both Truck & Car
+        // Truck was still virtually inheriting from Vehicle:  class Truck : virtual public Vehicle
+        // but Car was non-virtually inheriting from Vehicle:  class Car : public Vehicle
+        // then one vehicle constructor would be calles by Bus, not Truck
+        // and another by Car
+
+        // The constructor order is determined by two rules:
+        // Virtual base classes are constructed first (by the most derived class).
+        // Then non-virtual base classes, in the order they appear in the class declaration.
+        // Then the derived class itself.
+
+        // So for Bus, the order is:
+        // 1. Vehicle (the virtual base, constructed by Bus — for Truck's path)
+        // 2. Vehicle (the one inside Car — non-virtual, Car constructs its own)
+        // 3. Car
+        // 4. Truck
+        // 5. Bus
+    }
 
-    cout << "---- Bus object ----\n";
-    Bus b;
-    // ---- Bus object ----
-    // Vehicle constructor, maxSpeed = 5
-    // Car constructor
-    // Truck constructor
-    // Bus constructor
-    b.print_speed();
-    // Truck sees max speed = 5
-
-    // No ambiguity anymore
-    b.color = "Yellow";
-
-    cout << "Shared Vehicle color = " << b.color << endl;
-    // Shared Vehicle color = Yellow
-
-    // Only ONE Vehicle exists
-    // Bus destructor
-    // Truck destructor
-    // Car destructor
-    // Vehicle destructor
-
-
-    // Note:
-    // 1.
-    // If bus was only inheriting from only one class, say Truck
-    // which was still inheriting: class Truck : virtual public Vehicle
-    // then the vehicle constructor would be calles by Bus, not Truck
-    // The most derived class always initializes virtual bases — even if only one path exists.
-
-    // 2.
-    // If bus was still inheriting from both Truck & Car
-    // Truck was still virtually inheriting from Vehicle:  class Truck : virtual public Vehicle
-    // but Car was non-virtually inheriting from Vehicle:  class Car : public Vehicle
-    // then one vehicle constructor would be calles by Bus, not Truck
-    // and another by Car
-
-    // The constructor order is determined by two rules:
-    // Virtual base classes are constructed first (by the most derived class).
-    // Then non-virtual base classes, in the order they appear in the class declaration.
-    // Then the derived class itself.
-
-    // So for Bus, the order is:
-    // 1. Vehicle (the virtual base, constructed by Bus — for Truck's path)
-    // 2. Vehicle (the one inside Car — non-virtual, Car constructs its own)
-    // 3. Car
-    // 4. Truck
-    // 5. Bus
+    cout << "\n--- constructors and destructors, in the order they ran ---\n";
+    print_lifecycle_trace(cout, collect_lifecycle_trace());
+    //      0.000 us  thread 0  construct Vehicle    +24    <- first, by Bus; at the END of the object
+    //      0.104 us  thread 0  construct Car        +0
+    //      0.181 us  thread 0  construct Truck      +16
+    //      0.226 us  thread 0  construct Bus        +0
+    //     16.956 us  thread 0  destroy   Bus        +0
+    //     17.367 us  thread 0  destroy   Truck      +16
+    //     17.405 us  thread 0  destroy   Car        +0
+    //     17.449 us  thread 0  destroy   Vehicle    +24    <- ONE Vehicle: constructed once, destroyed once
 
     return 0;
 }
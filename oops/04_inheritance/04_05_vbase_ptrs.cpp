@@ -5,6 +5,8 @@
 #include <iostream>
 using namespace std;
 
+#include "layout_report.h"
+
 // ============================================================
 // CHAPTER 1: THE PROBLEM — DIAMOND INHERITANCE
 // ============================================================
@@ -143,18 +145,14 @@ public:
 // Lion:
 //   [ vbase ptr(8) ] ← points to shared Animal
 //   [ lion_data(4) ]
-//   [ padding(4)   ]
-//   [ Animal::age(4) ] ← shared Animal subobject placed at end
-//   [ padding(4)   ]
-//   sizeof = 24
+//   [ Animal::age(4) ] ← shared Animal subobject placed at end (4-aligned: fits right after lion_data)
+//   sizeof = 16
 
 // Tiger:
 //   [ vbase ptr(8)   ]
 //   [ tiger_data(4)  ]
-//   [ padding(4)     ]
 //   [ Animal::age(4) ]
-//   [ padding(4)     ]
-//   sizeof = 24
+//   sizeof = 16
 
 // Liger:
 //   [ Lion's vbase ptr(8)  ] ← Lion subobject start
@@ -289,6 +287,30 @@ public:
 // In both cases the MECHANISM is the same — locate shared base at runtime.
 // The IMPLEMENTATION differs based on whether a vptr already exists.
 
+// ============================================================
+// LAYOUT BUDGETS: the sizes above, checked by the compiler
+// (layout_report.h: the build fails if a class outgrows its budget,
+//  print_layout_report() at the end of main shows the object maps)
+//
+//            class       size  overhead (hidden pointers + padding)
+// ============================================================
+
+LAYOUT_REPORT(Animal_NV,     4,  0, LAYOUT_FIELD(age));
+LAYOUT_REPORT(Lion_NV,       8,  0, LAYOUT_FIELD(age), LAYOUT_FIELD(lion_data));
+LAYOUT_REPORT(Tiger_NV,      8,  0, LAYOUT_FIELD(age), LAYOUT_FIELD(tiger_data));
+LAYOUT_REPORT(Liger_NV,     20,  0, LAYOUT_FIELD(Lion_NV::age), LAYOUT_FIELD(lion_data),
+                                    LAYOUT_FIELD(Tiger_NV::age), LAYOUT_FIELD(tiger_data), LAYOUT_FIELD(liger_data));
+LAYOUT_REPORT(Animal,        4,  0, LAYOUT_FIELD(age));
+LAYOUT_REPORT(Lion,         16,  8, LAYOUT_FIELD(age), LAYOUT_FIELD(lion_data));
+LAYOUT_REPORT(Tiger,        16,  8, LAYOUT_FIELD(age), LAYOUT_FIELD(tiger_data));
+LAYOUT_REPORT(Liger,        40, 24, LAYOUT_FIELD(age), LAYOUT_FIELD(lion_data), LAYOUT_FIELD(tiger_data),
+                                    LAYOUT_FIELD(liger_data));
+LAYOUT_REPORT(Base,         16, 12, LAYOUT_FIELD(base_data));
+LAYOUT_REPORT(Left,         32, 24, LAYOUT_FIELD(base_data), LAYOUT_FIELD(left_data));
+LAYOUT_REPORT(Right,        32, 24, LAYOUT_FIELD(base_data), LAYOUT_FIELD(right_data));
+LAYOUT_REPORT(Child,        48, 32, LAYOUT_FIELD(base_data), LAYOUT_FIELD(left_data), LAYOUT_FIELD(right_data),
+                                    LAYOUT_FIELD(child_data));
+
 // ============================================================
 // CHAPTER 9: VERIFY WITH CODE
 // ============================================================
@@ -302,8 +324,8 @@ int main() {
 
     cout << "\n=== Chapter 5: Virtual inheritance, no virtual functions ===\n";
     cout << "sizeof(Animal): " << sizeof(Animal) << "\n";  // 4
-    cout << "sizeof(Lion):   " << sizeof(Lion)   << "\n";  // 24 — vbase ptr added
-    cout << "sizeof(Tiger):  " << sizeof(Tiger)  << "\n";  // 24
+    cout << "sizeof(Lion):   " << sizeof(Lion)   << "\n";  // 16 — vbase ptr added
+    cout << "sizeof(Tiger):  " << sizeof(Tiger)  << "\n";  // 16
     cout << "sizeof(Liger):  " << sizeof(Liger)  << "\n";  // 40 — one shared Animal
 
     cout << "\n=== Chapter 6: Virtual inheritance + virtual functions ===\n";
@@ -323,6 +345,9 @@ int main() {
     Base* bp = &child;
     bp->speak();  // Left::speak — Left is the final overrider
 
+    cout << "\n=== Layout report ===\n";
+    print_layout_report(cout);
+
     return 0;
 }
 
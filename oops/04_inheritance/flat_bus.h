@@ -0,0 +1,137 @@
+// the Bus diamond of 04_04_virtual_inheritance.cpp without virtual inheritance
+// one Vehicle at a FIXED offset (the first base), Car and Truck as CRTP parts that reach it by static_cast
+
+#pragma once
+
+#include <iostream>
+#include <string>
+
+// 04_04: class Car : virtual public Vehicle, class Truck : virtual public Vehicle, class Bus : public Car, public Truck
+//   - one shared Vehicle, but Car's and Truck's code don't know where it is: it depends on the most derived class.
+//     Every access to a Vehicle member from Car / Truck code (or through a Car&, Truck&, even Bus&) is:
+//       load the vptr, load the vbase offset from the vtable, add it to this, then load the member
+//   - every Car / Truck subobject carries a hidden pointer for that (Bus: two), + padding
+//
+// Here the diamond is flattened:
+//   FlatVehicle                 the Vehicle state, unchanged (maxSpeed private, numTyres protected, color public)
+//   CarPart<Derived>            what Car adds (numGears, its constructor); no Vehicle inside it
+//   TruckPart<Derived>          what Truck adds (print_speed()); no Vehicle inside it
+//   FlatBus : FlatVehicle, CarPart<FlatBus>, TruckPart<FlatBus>
+//                               the Vehicle is the first base: offset 0, known at compile time.
+//   A part reaches it with static_cast<Derived&>(*this) -- a constant pointer adjustment, no table lookup.
+//   FlatCar and FlatTruck are the standalone Car and Truck, built the same way.
+//
+// Same observable API and behaviour: b.color, b.max_speed(), b.numGears, b.print_speed(), numTyres set by the parts,
+// the same constructor / destructor messages in the same order.
+// What is lost: "a Car" is no longer one type -- CarPart<FlatBus> and CarPart<FlatCar> are unrelated,
+// so there is no Car& that binds to both a car and a bus. Code that needs one is written as a template
+// (like print_speed below), or takes the FlatVehicle& it actually uses.
+
+template <typename Derived> class CarPart;
+template <typename Derived> class TruckPart;
+
+class FlatVehicle {
+private:
+    int maxSpeed;
+
+protected:
+    int numTyres;
+
+    // the parts set numTyres in their constructors, as Car and Truck do
+    template <typename Derived> friend class CarPart;
+    template <typename Derived> friend class TruckPart;
+
+public:
+    std::string color;
+
+    FlatVehicle(int z) : maxSpeed(z), numTyres(0) {
+        std::cout << "Vehicle constructor, maxSpeed = " << z << std::endl;
+    }
+
+    int max_speed() const {
+        return maxSpeed;
+    }
+
+    int num_tyres() const {
+        return numTyres;
+    }
+
+    // not virtual, as in 04_04: never deleted through a FlatVehicle*
+    ~FlatVehicle() {
+        std::cout << "Vehicle destructor" << std::endl;
+    }
+};
+
+template <typename Derived>
+class CarPart {
+public:
+    int numGears;
+
+    // the Vehicle is passed in: it is already constructed (it is the first base), the part only sets it up
+    // (passed as static_cast<FlatVehicle&>(*this): a plain *this would also match the copy constructor)
+    explicit CarPart(FlatVehicle &vehicle) : numGears(5) {
+        std::cout << "Car constructor" << std::endl;
+        vehicle.numTyres = 4;
+    }
+
+    ~CarPart() {
+        std::cout << "Car destructor" << std::endl;
+    }
+
+    // the shared Vehicle: a fixed offset from this part, resolved at compile time
+    FlatVehicle& vehicle() {
+        return static_cast<Derived&>(*this);
+    }
+
+    const FlatVehicle& vehicle() const {
+        return static_cast<const Derived&>(*this);
+    }
+};
+
+template <typename Derived>
+class TruckPart {
+public:
+    explicit TruckPart(FlatVehicle &vehicle) {
+        std::cout << "Truck constructor" << std::endl;
+        vehicle.numTyres = 8;
+    }
+
+    void print_speed() const {
+        std::cout << "Truck sees max speed = " << vehicle().max_speed() << std::endl;
+    }
+
+    ~TruckPart() {
+        std::cout << "Truck destructor" << std::endl;
+    }
+
+    FlatVehicle& vehicle() {
+        return static_cast<Derived&>(*this);
+    }
+
+    const FlatVehicle& vehicle() const {
+        return static_cast<const Derived&>(*this);
+    }
+};
+
+class FlatCar : public FlatVehicle, public CarPart<FlatCar> {
+public:
+    FlatCar() : FlatVehicle(3), CarPart<FlatCar>(static_cast<FlatVehicle&>(*this)) {}
+};
+
+class FlatTruck : public FlatVehicle, public TruckPart<FlatTruck> {
+public:
+    FlatTruck() : FlatVehicle(4), TruckPart<FlatTruck>(static_cast<FlatVehicle&>(*this)) {}
+};
+
+// base order = construction order: Vehicle, Car, Truck, Bus (as with the virtual base); destruction in reverse
+class FlatBus : public FlatVehicle, public CarPart<FlatBus>, public TruckPart<FlatBus> {
+public:
+    FlatBus() : FlatVehicle(5), CarPart<FlatBus>(static_cast<FlatVehicle&>(*this)),
+                TruckPart<FlatBus>(static_cast<FlatVehicle&>(*this)) {
+        std::cout << "Bus constructor" << std::endl;
+    }
+
+    ~FlatBus() {
+        std::cout << "Bus destructor" << std::endl;
+    }
+};
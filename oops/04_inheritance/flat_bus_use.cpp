@@ -0,0 +1,189 @@
+// build: g++ -std=c++20 -O2 flat_bus_use.cpp
+// usage: ./a.out [buses]        (default 1M)
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../01_basics/timing.h"
+#include "flat_bus.h"
+
+// ------------------------------------------------------------
+// The virtual-inheritance version, for comparison: 04_04_virtual_inheritance.cpp's classes
+// ------------------------------------------------------------
+
+class Vehicle {
+private:
+    int maxSpeed;
+
+protected:
+    int numTyres;
+
+public:
+    std::string color;
+
+    Vehicle(int z) : maxSpeed(z), numTyres(0) {
+        std::cout << "Vehicle constructor, maxSpeed = " << z << std::endl;
+    }
+
+    int max_speed() const {
+        return maxSpeed;
+    }
+
+    ~Vehicle() {
+        std::cout << "Vehicle destructor" << std::endl;
+    }
+};
+
+class Car : virtual public Vehicle {
+public:
+    int numGears;
+
+    Car() : Vehicle(3), numGears(5) {
+        std::cout << "Car constructor" << std::endl;
+        numTyres = 4;
+    }
+
+    ~Car() {
+        std::cout << "Car destructor" << std::endl;
+    }
+};
+
+class Truck : virtual public Vehicle {
+public:
+    Truck() : Vehicle(4) {
+        std::cout << "Truck constructor" << std::endl;
+        numTyres = 8;
+    }
+
+    void print_speed() {
+        std::cout << "Truck sees max speed = " << max_speed() << std::endl;
+    }
+
+    ~Truck() {
+        std::cout << "Truck destructor" << std::endl;
+    }
+};
+
+class Bus : public Car, public Truck {
+public:
+    Bus() : Vehicle(5) {
+        std::cout << "Bus constructor" << std::endl;
+    }
+
+    ~Bus() {
+        std::cout << "Bus destructor" << std::endl;
+    }
+};
+
+// "Truck code": compiled once, for any object that contains a Truck
+__attribute__((noinline)) int truck_speed(const Truck &truck) {
+    return truck.max_speed();      // vptr -> vbase offset -> Vehicle -> maxSpeed
+}
+
+template <typename Derived>
+__attribute__((noinline)) int flat_truck_speed(const TruckPart<Derived> &truck) {
+    return truck.vehicle().max_speed();   // this - constant -> maxSpeed
+}
+
+int main(int argc, char **argv) {
+    {
+        std::cout << "---- FlatBus object ----\n";
+        FlatBus b;
+        // ---- FlatBus object ----
+        // Vehicle constructor, maxSpeed = 5
+        // Car constructor
+        // Truck constructor
+        // Bus constructor
+        b.print_speed();
+        // Truck sees max speed = 5
+
+        b.color = "Yellow";   // one Vehicle: no ambiguity, as with virtual inheritance
+        std::cout << "Shared Vehicle color = " << b.color << ", tyres = " << b.num_tyres()
+                  << ", gears = " << b.numGears << std::endl;
+        // Shared Vehicle color = Yellow, tyres = 8, gears = 5
+    }
+    // Bus destructor
+    // Truck destructor
+    // Car destructor
+    // Vehicle destructor
+
+    std::cout << "sizeof(Car) " << sizeof(Car) << ", sizeof(Truck) " << sizeof(Truck) << ", sizeof(Bus) " << sizeof(Bus) << '\n';
+    std::cout << "sizeof(FlatCar) " << sizeof(FlatCar) << ", sizeof(FlatTruck) " << sizeof(FlatTruck)
+              << ", sizeof(FlatBus) " << sizeof(FlatBus) << '\n';
+    // sizeof(Car) 56, sizeof(Truck) 48, sizeof(Bus) 64
+    // sizeof(FlatCar) 48, sizeof(FlatTruck) 40, sizeof(FlatBus) 48
+
+    // ------------------------------------------------------------
+    // Benchmark: reading a Vehicle member, n buses
+    // ------------------------------------------------------------
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    constexpr int kRounds = 20;
+
+    std::cout.setstate(std::ios::badbit);   // n * 4 constructor messages: discarded
+    std::vector<Bus> buses(n);
+    std::vector<FlatBus> flat_buses(n);
+    std::cout.clear();
+
+    // the four arms take turns, one pass each per round, after a warm-up pass each: run one after another,
+    // the first arm paid for the page faults and cold caches, and frequency drift landed on whichever ran last.
+    // Each pass sums into a local: summed into totals[i] directly, the total stayed in memory, and a store /
+    // load per bus (~1 ns) hid most of the difference while the buses were in cache.
+    long long totals[4] = {0, 0, 0, 0};
+    double bus_ms = 0, truck_ms = 0, flat_bus_ms = 0, flat_truck_ms = 0;
+    for(int round = -1; round < kRounds; round++) {   // round -1: the warm-up, not timed
+        const double bus_pass = time_ms([&] {
+            long long total = 0;
+            for(const Bus &b : buses)
+                total += b.max_speed();
+            totals[0] += total;
+        });
+        const double truck_pass = time_ms([&] {
+            long long total = 0;
+            for(const Bus &b : buses)
+                total += truck_speed(b);
+            totals[1] += total;
+        });
+        const double flat_bus_pass = time_ms([&] {
+            long long total = 0;
+            for(const FlatBus &b : flat_buses)
+                total += b.max_speed();
+            totals[2] += total;
+        });
+        const double flat_truck_pass = time_ms([&] {
+            long long total = 0;
+            for(const FlatBus &b : flat_buses)
+                total += flat_truck_speed(b);
+            totals[3] += total;
+        });
+        if(round >= 0) {
+            bus_ms += bus_pass;
+            truck_ms += truck_pass;
+            flat_bus_ms += flat_bus_pass;
+            flat_truck_ms += flat_truck_pass;
+        }
+    }
+
+    const double accesses = static_cast<double>(n) * kRounds;
+    std::cout << n << " buses x " << kRounds << " rounds, same totals: "
+              << (totals[0] == totals[1] && totals[1] == totals[2] && totals[2] == totals[3]) << '\n';
+    std::cout << "Bus&, inline:              " << bus_ms * 1e6 / accesses << " ns / access\n";
+    std::cout << "Truck&, out-of-line:       " << truck_ms * 1e6 / accesses << " ns / access\n";
+    std::cout << "FlatBus&, inline:          " << flat_bus_ms * 1e6 / accesses << " ns / access\n";
+    std::cout << "TruckPart&, out-of-line:   " << flat_truck_ms * 1e6 / accesses << " ns / access\n";
+
+    // measured (-O2, 1-core VM, arms interleaved). Absolute times vary from run to run and a lot between
+    // machines (1M buses elsewhere: ~4.4 / ~2.9 virtual, ~2.35 / ~2.12 flat); compare within one run:
+    //                            1M buses (~110 MB, DRAM)   10K buses (in cache)
+    //   Bus&, inline             ~6.0-6.4 ns                ~0.85 ns    vptr -> vbase offset -> maxSpeed
+    //   Truck&, out-of-line      ~6.9-7.8                   ~1.2-1.8
+    //   FlatBus&, inline         ~4.0-4.4                   ~0.4        maxSpeed at a fixed offset
+    //   TruckPart&, out-of-line  ~5.6-6.3                   ~1.15       this - constant, then maxSpeed
+    // In cache, the inline read is ~2x faster flat: one load instead of three dependent ones. Out of line, the
+    // call costs about as much as the loads. From DRAM the flat objects win ~1.2-1.5x, partly for being
+    // 16 bytes smaller: no hidden pointers in the Car and Truck parts, so fewer cache lines per bus.
+
+    std::cout.setstate(std::ios::badbit);   // and n * 4 destructor messages
+    return 0;
+}
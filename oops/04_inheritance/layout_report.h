@@ -0,0 +1,166 @@
+// object layout budgets and reports: sizeof / alignment / padding / hidden pointers / field offsets
+// LAYOUT_REPORT(Class, max_size, max_overhead, LAYOUT_FIELD(member)...) -- the build fails if a budget is exceeded
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iomanip>
+#include <new>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// LAYOUT_REPORT(Liger, 40, 24, LAYOUT_FIELD(age), LAYOUT_FIELD(lion_data), ...)
+//   static_assert:  sizeof(Liger) <= 40, and sizeof(Liger) - sum of field sizes <= 24
+//                   (hidden pointers + padding) -- a new vptr or vbase ptr fails the build
+//   print_layout_report(cout): size, alignment, every field's offset, hidden pointers and padding
+//
+// No trait counts hidden pointers, and offsetof can't reach a virtual base's members, so they are found on
+// a real object: the storage is filled with a pattern, the object default-constructed into it, and every
+// pointer-sized word outside the fields that the constructor wrote is a hidden pointer -- a vptr if the
+// class is polymorphic, a vbase ptr otherwise (see 04_05_vbase_ptrs.cpp, chapter 7).
+//
+// Fields: every data member, inherited ones too, each once; qualify ambiguous ones, LAYOUT_FIELD(Lion_NV::age).
+// They must be accessible where the report is declared, and the class must be default-constructible.
+
+struct LayoutField {
+    std::string name;
+    std::size_t offset;
+    std::size_t size;
+};
+
+struct LayoutInfo {
+    std::string name;
+    std::size_t size;
+    std::size_t align;
+    std::size_t max_size;        // budgets
+    std::size_t max_overhead;
+    bool polymorphic;
+    std::vector<LayoutField> fields;                 // by offset
+    std::vector<std::size_t> hidden_pointer_offsets;
+    std::size_t field_bytes;
+    std::size_t padding_bytes;
+};
+
+namespace layout_report_detail {
+
+constexpr unsigned char kPattern = 0xA5;
+
+// LAYOUT_FIELD(m) is a generic lambda T* -> &t->m: the field's type (and so its size) is known at compile time
+template <typename T, typename Field>
+constexpr std::size_t field_size() {
+    return sizeof(std::remove_pointer_t<decltype(std::declval<Field>()(std::declval<T*>()))>);
+}
+
+template <typename T, typename... Fields>
+constexpr std::size_t overhead_bytes(Fields...) {
+    return sizeof(T) - (std::size_t{0} + ... + field_size<T, Fields>());
+}
+
+template <typename T, typename Field>
+LayoutField locate(const unsigned char *base, T *object, const char *name, Field field) {
+    const auto *address = reinterpret_cast<const unsigned char*>(field(object));
+    return LayoutField{name, static_cast<std::size_t>(address - base), field_size<T, Field>()};
+}
+
+// member names, split from the stringized LAYOUT_FIELD list ("LAYOUT_FIELD(age), LAYOUT_FIELD(lion_data)")
+inline std::vector<std::string> field_names(const char *fields) {
+    std::vector<std::string> names;
+    const std::string text(fields);
+    constexpr std::string_view kOpen = "LAYOUT_FIELD(";
+    for(std::size_t at = text.find(kOpen); at != std::string::npos; at = text.find(kOpen, at)) {
+        at += kOpen.size();
+        const std::size_t close = text.find(')', at);
+        std::string name = text.substr(at, close - at);
+        name.erase(std::remove(name.begin(), name.end(), ' '), name.end());
+        names.push_back(name);
+        at = close;
+    }
+    return names;
+}
+
+inline std::vector<LayoutInfo>& registry() {
+    static std::vector<LayoutInfo> layouts;
+    return layouts;
+}
+
+template <typename T, typename... Fields>
+bool add(const char *name, std::size_t max_size, std::size_t max_overhead, const char *field_list, Fields... fields) {
+    LayoutInfo info{name, sizeof(T), alignof(T), max_size, max_overhead, std::is_polymorphic_v<T>, {}, {}, 0, 0};
+
+    alignas(T) unsigned char storage[sizeof(T)];
+    std::memset(storage, kPattern, sizeof(T));
+    T *object = new (storage) T;   // default-initialization: padding is left alone
+
+    const std::vector<std::string> names = field_names(field_list);
+    std::size_t i = 0;
+    (info.fields.push_back(locate(storage, object, names[i++].c_str(), fields)), ...);
+    std::sort(info.fields.begin(), info.fields.end(),
+              [](const LayoutField &a, const LayoutField &b) { return a.offset < b.offset; });
+
+    std::vector<bool> in_field(sizeof(T), false);
+    for(const LayoutField &f : info.fields) {
+        info.field_bytes += f.size;
+        std::fill(in_field.begin() + f.offset, in_field.begin() + f.offset + f.size, true);
+    }
+    for(std::size_t word = 0; word + sizeof(void*) <= sizeof(T); word += alignof(void*)) {
+        bool free = true, written = false;
+        for(std::size_t b = word; b < word + sizeof(void*); b++) {
+            free = free && !in_field[b];
+            written = written || storage[b] != kPattern;
+        }
+        if(free && written)
+            info.hidden_pointer_offsets.push_back(word);
+    }
+    info.padding_bytes = sizeof(T) - info.field_bytes - info.hidden_pointer_offsets.size() * sizeof(void*);
+
+    object->~T();
+    registry().push_back(std::move(info));
+    return true;
+}
+
+}   // namespace layout_report_detail
+
+
+#define LAYOUT_FIELD(member) [](auto *layout_object_) { return &layout_object_->member; }
+
+#define LAYOUT_REPORT(Class, max_size, max_overhead, ...)                                                        \
+    static_assert(sizeof(Class) <= (max_size), "layout budget exceeded: sizeof(" #Class ") > " #max_size);      \
+    static_assert(layout_report_detail::overhead_bytes<Class>(__VA_ARGS__) <= (max_overhead),                  \
+                  "layout budget exceeded: " #Class " has more than " #max_overhead " bytes of hidden pointers + padding"); \
+    inline const bool layout_report_registered_##Class =                                                         \
+        layout_report_detail::add<Class>(#Class, max_size, max_overhead, #__VA_ARGS__, __VA_ARGS__)
+
+// every registered class, in declaration order
+inline void print_layout_report(std::ostream &os) {
+    for(const LayoutInfo &info : layout_report_detail::registry()) {
+        const std::size_t hidden = info.hidden_pointer_offsets.size();
+        os << info.name << ": size " << info.size << " (budget " << info.max_size << "), align " << info.align
+           << ", fields " << info.field_bytes << ", ";
+        if(hidden == 0)
+            os << "no hidden pointers";
+        else
+            os << hidden << (info.polymorphic ? " vptr" : " vbase ptr") << (hidden == 1 ? "" : "s");
+        os << ", padding " << info.padding_bytes
+           << " (overhead " << info.size - info.field_bytes << ", budget " << info.max_overhead << ")\n";
+
+        // the object map, in offset order
+        std::size_t f = 0, h = 0;
+        while(f < info.fields.size() || h < hidden) {
+            if(h < hidden && (f == info.fields.size() || info.hidden_pointer_offsets[h] < info.fields[f].offset)) {
+                os << "  " << std::setw(4) << info.hidden_pointer_offsets[h] << "  "
+                   << (info.polymorphic ? "[vptr]" : "[vbase ptr]") << " (" << sizeof(void*) << ")\n";
+                h++;
+            }
+            else {
+                os << "  " << std::setw(4) << info.fields[f].offset << "  " << info.fields[f].name
+                   << " (" << info.fields[f].size << ")\n";
+                f++;
+            }
+        }
+    }
+}
@@ -0,0 +1,385 @@
+// object lifecycle tracing: constructor / destructor events (type, address, TSC timestamp) into per-thread rings,
+// exported afterwards as a Chrome trace (JSON) or a compact binary file
+
+#pragma once
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Instead of  cout << "Car's constructor" << endl;  (a write() syscall per event):
+//   trace_constructed(this, "Car") / trace_destroyed(this, "Car")
+//   disabled (the default):  a relaxed load of a global flag and a never-taken branch
+//   enabled:                 a 32-byte event into this thread's ring, no lock, no syscall, no allocation:
+//                              [ TSC timestamp | object address | type name | thread | construct / destroy ]
+//   compiled out:            -DLIFECYCLE_TRACE=0
+//
+// A full ring overwrites its oldest events (counted in the trace); an exited thread's ring is reused by a new
+// thread once its events have been collected. Once the traced threads are done,
+// collect_lifecycle_trace() merges the rings by timestamp and converts ticks to microseconds;
+// then print_lifecycle_trace(cout, trace), write_chrome_trace(path, trace) (chrome://tracing or
+// ui.perfetto.dev: one bar per object, constructor to destructor), or write_binary_trace(path, trace)
+// (24 bytes per event; read_binary_trace(path) reads it back).
+
+#ifndef LIFECYCLE_TRACE
+#define LIFECYCLE_TRACE 1
+#endif
+
+enum class LifecycleEventKind : std::uint8_t { Construct, Destroy };
+
+// an event as collected / stored in the binary file: type names as an index into LifecycleTrace::types
+struct TracedEvent {
+    std::uint64_t ticks;      // TSC
+    std::uint64_t address;
+    std::uint32_t type;
+    std::uint16_t thread;     // in order of each thread's first event
+    LifecycleEventKind kind;
+    std::uint8_t reserved;
+};
+static_assert(sizeof(TracedEvent) == 24, "event layout is part of the file format");
+
+struct LifecycleTrace {
+    double ticks_per_us = 1000;
+    std::vector<std::string> types;
+    std::vector<TracedEvent> events;   // by timestamp
+    std::uint64_t overwritten = 0;     // events lost to full rings
+};
+
+// File layout (native byte order):
+//   LifecycleTraceHeader (32 bytes)   magic "LCTR" | version | type count | event count | ticks per us
+//   type names                        type count x (uint32 length, bytes)
+//   TracedEvent[event count]
+//   uint64 overwritten
+struct LifecycleTraceHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t type_count;
+    std::uint32_t reserved;
+    std::uint64_t event_count;
+    double ticks_per_us;
+};
+static_assert(sizeof(LifecycleTraceHeader) == 32, "header layout is part of the file format");
+
+constexpr char kLifecycleTraceMagic[4] = {'L', 'C', 'T', 'R'};
+constexpr std::uint32_t kLifecycleTraceVersion = 1;
+
+
+namespace lifecycle_trace_detail {
+
+inline std::atomic<bool> g_enabled{false};
+
+inline std::uint64_t read_ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    // no TSC: nanoseconds, so ticks_per_us is 1000
+    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+inline std::uint64_t steady_ns() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// a recorded event, as the owning thread writes it: the type name is still the literal's address
+struct RawEvent {
+    std::uint64_t ticks;
+    const void *address;
+    const char *type;
+    std::uint16_t thread;
+    LifecycleEventKind kind;
+};
+static_assert(sizeof(RawEvent) == 32, "half a cache line per event");
+
+class TraceRing {
+
+public:
+    static constexpr std::size_t kEvents = 1 << 15;   // 1 MB per traced thread
+
+    explicit TraceRing(std::uint16_t thread) : events_(std::make_unique<RawEvent[]>(kEvents)), thread_(thread) {}
+
+    // owning thread only
+    void record(LifecycleEventKind kind, const void *address, const char *type) {
+        const std::uint64_t head = head_.load(std::memory_order_relaxed);
+        events_[head % kEvents] = RawEvent{read_ticks(), address, type, thread_, kind};
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    // f(event) for the events still in the ring, oldest first; returns how many were overwritten
+    template <typename F>
+    std::uint64_t for_each(F &&f) const {
+        const std::uint64_t head = head_.load(std::memory_order_acquire);
+        const std::uint64_t first = head > kEvents ? head - kEvents : 0;
+        for(std::uint64_t i = first; i < head; i++)
+            f(events_[i % kEvents]);
+        return first;
+    }
+
+    void clear() {
+        head_.store(0, std::memory_order_release);
+    }
+
+    // hands a collected ring to a new thread (registry mutex held)
+    void reuse(std::uint16_t thread) {
+        clear();
+        thread_ = thread;
+        collected = false;
+        abandoned.store(false, std::memory_order_release);
+    }
+
+    std::atomic<bool> abandoned{false};   // the owning thread has exited
+    bool collected = false;               // abandoned, and every event it left has been collected (registry mutex)
+
+private:
+    std::unique_ptr<RawEvent[]> events_;
+    std::atomic<std::uint64_t> head_{0};
+    std::uint16_t thread_;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<TraceRing>> rings;   // kept after a thread exits, until its events are collected
+    std::uint16_t next_thread = 0;
+    std::uint64_t calibration_ticks = 0;             // (TSC, steady_clock) when tracing was enabled
+    std::uint64_t calibration_ns = 0;
+};
+
+inline Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+struct ThreadRing {
+    std::shared_ptr<TraceRing> ring;
+    ~ThreadRing() {
+        if(ring)
+            ring->abandoned.store(true, std::memory_order_release);
+    }
+};
+
+// the enabled path: out of line, so the disabled check inlined at every call site stays one load and one branch
+[[gnu::noinline, gnu::cold]] inline void record(LifecycleEventKind kind, const void *address, const char *type) {
+    thread_local ThreadRing mine;
+    if(!mine.ring) {
+        // a ring whose thread has exited and whose events have been collected is reused, so threads that come
+        // and go (a pool's workers, one thread per request) don't leave 1 MB each behind
+        Registry &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        const auto spare = std::find_if(r.rings.begin(), r.rings.end(),
+                                        [](const std::shared_ptr<TraceRing> &ring) { return ring->collected; });
+        if(spare != r.rings.end()) {
+            (*spare)->reuse(r.next_thread++);
+            mine.ring = *spare;
+        }
+        else {
+            mine.ring = std::make_shared<TraceRing>(r.next_thread++);
+            r.rings.push_back(mine.ring);
+        }
+    }
+    mine.ring->record(kind, address, type);
+}
+
+}   // namespace lifecycle_trace_detail
+
+
+inline void lifecycle_trace_enable() {
+    lifecycle_trace_detail::Registry &r = lifecycle_trace_detail::registry();
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.calibration_ticks = lifecycle_trace_detail::read_ticks();
+        r.calibration_ns = lifecycle_trace_detail::steady_ns();
+    }
+    lifecycle_trace_detail::g_enabled.store(true, std::memory_order_release);
+}
+
+inline void lifecycle_trace_disable() {
+    lifecycle_trace_detail::g_enabled.store(false, std::memory_order_release);
+}
+
+// call from constructors / destructors, with a string literal for the type
+inline void trace_constructed([[maybe_unused]] const void *self, [[maybe_unused]] const char *type) {
+#if LIFECYCLE_TRACE
+    if(lifecycle_trace_detail::g_enabled.load(std::memory_order_relaxed)) [[unlikely]]
+        lifecycle_trace_detail::record(LifecycleEventKind::Construct, self, type);
+#endif
+}
+
+inline void trace_destroyed([[maybe_unused]] const void *self, [[maybe_unused]] const char *type) {
+#if LIFECYCLE_TRACE
+    if(lifecycle_trace_detail::g_enabled.load(std::memory_order_relaxed)) [[unlikely]]
+        lifecycle_trace_detail::record(LifecycleEventKind::Destroy, self, type);
+#endif
+}
+
+// every thread's events, merged by time. Call when the traced threads are done (or not constructing anything):
+// an event being written while it is read may come out torn.
+// A thread that has exited is collected once: its ring then goes to the next new thread, and later
+// collects no longer show its events. Live threads' events come back every time, until cleared.
+inline LifecycleTrace collect_lifecycle_trace() {
+    using namespace lifecycle_trace_detail;
+    Registry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    LifecycleTrace trace;
+    std::unordered_map<const char*, std::uint32_t> type_index;   // one literal, one index
+    for(const std::shared_ptr<TraceRing> &ring : r.rings) {
+        if(ring->collected)
+            continue;   // its events went out in an earlier collect; it waits for a new thread
+        const bool finished = ring->abandoned.load(std::memory_order_acquire);   // read first: nothing more comes
+        trace.overwritten += ring->for_each([&](const RawEvent &e) {
+            const auto [it, inserted] = type_index.try_emplace(e.type, static_cast<std::uint32_t>(trace.types.size()));
+            if(inserted)
+                trace.types.emplace_back(e.type);
+            trace.events.push_back(TracedEvent{e.ticks, reinterpret_cast<std::uintptr_t>(e.address), it->second,
+                                               e.thread, e.kind, 0});
+        });
+        ring->collected = finished;
+    }
+    // each ring is in order: a stable sort interleaves the threads and keeps it
+    std::stable_sort(trace.events.begin(), trace.events.end(),
+                     [](const TracedEvent &a, const TracedEvent &b) { return a.ticks < b.ticks; });
+
+#if defined(__x86_64__) || defined(__i386__)
+    // TSC rate: ticks against steady_clock since enable(), over at least a millisecond
+    while(steady_ns() - r.calibration_ns < 1'000'000) {}
+    trace.ticks_per_us = static_cast<double>(read_ticks() - r.calibration_ticks) * 1000.0
+                         / static_cast<double>(steady_ns() - r.calibration_ns);
+#endif
+    return trace;
+}
+
+// forget everything recorded so far (same caveat as collect: traced threads idle)
+inline void clear_lifecycle_trace() {
+    lifecycle_trace_detail::Registry &r = lifecycle_trace_detail::registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    std::erase_if(r.rings, [](const std::shared_ptr<lifecycle_trace_detail::TraceRing> &ring) {
+        return ring->abandoned.load(std::memory_order_acquire);
+    });
+    for(const auto &ring : r.rings)
+        ring->clear();
+}
+
+// one line per event: time since the first event, thread, event, type, and address as an offset from
+// the lowest address that thread traced -- for one object, where each subobject sits in it
+inline void print_lifecycle_trace(std::ostream &os, const LifecycleTrace &trace) {
+    if(trace.events.empty())
+        return;
+    std::unordered_map<std::uint16_t, std::uint64_t> lowest;   // per thread: threads' stacks are far apart
+    for(const TracedEvent &e : trace.events) {
+        const auto [it, inserted] = lowest.try_emplace(e.thread, e.address);
+        it->second = std::min(it->second, e.address);
+    }
+    const std::ios_base::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+    const std::uint64_t start = trace.events.front().ticks;
+    for(const TracedEvent &e : trace.events) {
+        os << std::fixed << std::setprecision(3) << std::setw(10)
+           << static_cast<double>(e.ticks - start) / trace.ticks_per_us << " us  thread " << e.thread << "  "
+           << (e.kind == LifecycleEventKind::Construct ? "construct " : "destroy   ")
+           << std::left << std::setw(10) << trace.types[e.type] << std::right << " +" << e.address - lowest[e.thread]
+           << '\n';
+    }
+    os.flags(flags);
+    os.precision(precision);
+    if(trace.overwritten != 0)
+        os << "(" << trace.overwritten << " older events overwritten)\n";
+}
+
+// Chrome trace event format: a nestable async span ("b" ... "e") per object, keyed by its address
+inline void write_chrome_trace(const std::string &path, const LifecycleTrace &trace) {
+    std::ofstream out(path, std::ios::trunc);
+    if(!out)
+        throw std::runtime_error("cannot open trace file for writing: " + path);
+    const std::uint64_t start = trace.events.empty() ? 0 : trace.events.front().ticks;
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n" << std::fixed << std::setprecision(3);
+    for(std::size_t i = 0; i < trace.events.size(); i++) {
+        const TracedEvent &e = trace.events[i];
+        out << "{\"name\":\"" << trace.types[e.type] << "\",\"cat\":\"lifecycle\",\"ph\":\""
+            << (e.kind == LifecycleEventKind::Construct ? 'b' : 'e') << "\",\"id\":\"0x" << std::hex << e.address
+            << std::dec << "\",\"ts\":" << static_cast<double>(e.ticks - start) / trace.ticks_per_us
+            << ",\"pid\":1,\"tid\":" << e.thread << '}' << (i + 1 < trace.events.size() ? ",\n" : "\n");
+    }
+    out << "]}\n";
+    out.flush();
+    if(!out)
+        throw std::runtime_error("error writing trace file: " + path);
+}
+
+inline void write_binary_trace(const std::string &path, const LifecycleTrace &trace) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if(!out)
+        throw std::runtime_error("cannot open trace file for writing: " + path);
+    LifecycleTraceHeader header{};
+    std::memcpy(header.magic, kLifecycleTraceMagic, sizeof(header.magic));
+    header.version = kLifecycleTraceVersion;
+    header.type_count = static_cast<std::uint32_t>(trace.types.size());
+    header.reserved = 0;
+    header.event_count = trace.events.size();
+    header.ticks_per_us = trace.ticks_per_us;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for(const std::string &name : trace.types) {
+        const auto length = static_cast<std::uint32_t>(name.size());
+        out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        out.write(name.data(), static_cast<std::streamsize>(name.size()));
+    }
+    out.write(reinterpret_cast<const char*>(trace.events.data()),
+              static_cast<std::streamsize>(trace.events.size() * sizeof(TracedEvent)));
+    out.write(reinterpret_cast<const char*>(&trace.overwritten), sizeof(trace.overwritten));
+    out.flush();
+    if(!out)
+        throw std::runtime_error("error writing trace file: " + path);
+}
+
+inline LifecycleTrace read_binary_trace(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    if(!in)
+        throw std::runtime_error("cannot open trace file: " + path);
+    LifecycleTraceHeader header{};
+    if(!in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        throw std::runtime_error("trace file too small: " + path);
+    if(std::memcmp(header.magic, kLifecycleTraceMagic, sizeof(header.magic)) != 0)
+        throw std::runtime_error("not a lifecycle trace file: " + path);
+    if(header.version != kLifecycleTraceVersion)
+        throw std::runtime_error("unsupported trace version " + std::to_string(header.version) + ": " + path);
+
+    LifecycleTrace trace;
+    trace.ticks_per_us = header.ticks_per_us;
+    for(std::uint32_t i = 0; i < header.type_count; i++) {
+        std::uint32_t length = 0;
+        if(!in.read(reinterpret_cast<char*>(&length), sizeof(length)) || length > 4096)
+            throw std::runtime_error("truncated or corrupt trace file: " + path);
+        std::string name(length, '\0');
+        in.read(name.data(), length);
+        trace.types.push_back(std::move(name));
+    }
+    if(header.event_count > (std::uint64_t{1} << 36) / sizeof(TracedEvent))
+        throw std::runtime_error("corrupt event count in trace file: " + path);
+    trace.events.resize(header.event_count);
+    in.read(reinterpret_cast<char*>(trace.events.data()),
+            static_cast<std::streamsize>(trace.events.size() * sizeof(TracedEvent)));
+    in.read(reinterpret_cast<char*>(&trace.overwritten), sizeof(trace.overwritten));
+    if(!in)
+        throw std::runtime_error("truncated or corrupt trace file: " + path);
+    for(const TracedEvent &e : trace.events) {
+        if(e.type >= trace.types.size())
+            throw std::runtime_error("corrupt type index in trace file: " + path);
+    }
+    return trace;
+}
@@ -0,0 +1,155 @@
+// build: g++ -std=c++20 -O2 -pthread lifecycle_trace_use.cpp
+//        g++ -std=c++20 -O2 -pthread -DLIFECYCLE_TRACE=0 lifecycle_trace_use.cpp    (tracing compiled out)
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "../01_basics/dev_null_timing.h"
+#include "lifecycle_trace.h"
+
+// the Vehicle / Car / Tesla of 04_01, with the constructor / destructor report as a parameter
+enum class Report { None, Print, Trace };
+
+template <Report R>
+void report(const void *self, const char *type, bool constructed) {
+    if constexpr(R == Report::Print)
+        std::cout << type << (constructed ? "'s constructor" : "'s destructor") << std::endl;
+    else if constexpr(R == Report::Trace)
+        constructed ? trace_constructed(self, type) : trace_destroyed(self, type);
+}
+
+template <Report R>
+class Vehicle {
+    private:
+        int maxSpeed;
+
+    protected:
+        int numTyres;
+
+    public:
+        Vehicle(int z) : maxSpeed(z), numTyres(4) {
+            report<R>(this, "Vehicle", true);
+        }
+
+        ~Vehicle() {
+            report<R>(this, "Vehicle", false);
+        }
+
+        int get_max_speed() const {
+            return maxSpeed;
+        }
+};
+
+template <Report R>
+class Car : public Vehicle<R> {
+    public:
+        int numGears;
+
+        Car(int x, int y) : Vehicle<R>(x), numGears(y) {
+            report<R>(this, "Car", true);
+        }
+
+        ~Car() {
+            report<R>(this, "Car", false);
+        }
+};
+
+template <Report R>
+class Tesla : public Car<R> {
+    public:
+        Tesla(int x, int y) : Car<R>(x, y) {
+            report<R>(this, "Tesla", true);
+        }
+
+        ~Tesla() {
+            report<R>(this, "Tesla", false);
+        }
+};
+
+// builds and destroys n Teslas; the result keeps the compiler from dropping the objects
+template <Report R>
+long long build_teslas(int n) {
+    long long total = 0;
+    for(int i = 0; i < n; i++) {
+        Tesla<R> t(i, 6);
+        asm volatile("" : : "r"(&t) : "memory");   // the object's address escapes: it must really exist
+        total += t.get_max_speed();
+    }
+    return total;
+}
+
+int main() {
+    const std::filesystem::path dir = std::filesystem::temp_directory_path();
+    const std::string json_path = (dir / "lifecycle.json").string();
+    const std::string binary_path = (dir / "lifecycle.bin").string();
+
+    lifecycle_trace_enable();
+    {
+        Tesla<Report::Trace> t(200, 6);
+        std::thread other([] { Car<Report::Trace> c(120, 5); });
+        other.join();
+    }
+    const LifecycleTrace trace = collect_lifecycle_trace();
+    print_lifecycle_trace(std::cout, trace);
+    //      0.000 us  thread 0  construct Vehicle    +0
+    //      0.119 us  thread 0  construct Car        +0
+    //      0.203 us  thread 0  construct Tesla      +0
+    //    690.176 us  thread 1  construct Vehicle    +0     <- another thread, its own ring (starting the thread: the 690 us)
+    //    690.429 us  thread 1  construct Car        +0
+    //    690.543 us  thread 1  destroy   Car        +0
+    //    690.572 us  thread 1  destroy   Vehicle    +0
+    //    731.876 us  thread 0  destroy   Tesla      +0
+    //    731.950 us  thread 0  destroy   Car        +0
+    //    731.990 us  thread 0  destroy   Vehicle    +0
+
+    write_chrome_trace(json_path, trace);
+    write_binary_trace(binary_path, trace);
+    std::cout << "chrome trace: " << std::filesystem::file_size(json_path) << " bytes, binary: "
+              << std::filesystem::file_size(binary_path) << " bytes\n";   // chrome trace: 996 bytes, binary: 307 bytes
+    // offline: the binary file back, and the same JSON from it
+    const LifecycleTrace loaded = read_binary_trace(binary_path);
+    const std::string converted_path = (dir / "lifecycle_converted.json").string();
+    write_chrome_trace(converted_path, loaded);
+    std::cout << "binary -> JSON matches: "
+              << (std::filesystem::file_size(converted_path) == std::filesystem::file_size(json_path) &&
+                  loaded.events.size() == trace.events.size() ? "yes" : "NO") << '\n';   // yes
+
+
+    // ------------------------------------------------------------
+    // Benchmark: build + destroy a Tesla (3 constructors, 3 destructors)
+    // ------------------------------------------------------------
+    constexpr int kObjects = 20'000'000;
+    constexpr int kPrinted = 200'000;   // endl is too slow for more
+    long long check = 0;
+
+    lifecycle_trace_disable();
+    const double none_ms = time_ms([&] { check += build_teslas<Report::None>(kObjects); });
+    const double disabled_ms = time_ms([&] { check += build_teslas<Report::Trace>(kObjects); });
+    lifecycle_trace_enable();
+    const double enabled_ms = time_ms([&] { check += build_teslas<Report::Trace>(kObjects); });
+    lifecycle_trace_disable();
+    const LifecycleTrace big = collect_lifecycle_trace();
+
+    const double printed_ms = time_to_dev_null_ms([&] { check += build_teslas<Report::Print>(kPrinted); });
+
+    std::cout << "no report:                " << none_ms * 1e6 / kObjects << " ns / object\n";
+    std::cout << "trace compiled in, off:   " << disabled_ms * 1e6 / kObjects << " ns / object\n";
+    std::cout << "trace on:                 " << enabled_ms * 1e6 / kObjects << " ns / object ("
+              << big.events.size() << " events kept, " << big.overwritten << " overwritten)\n";
+    std::cout << "cout << endl (/dev/null): " << printed_ms * 1e6 / kPrinted << " ns / object\n";
+    std::cout << "(check " << check << ")\n";
+
+    std::filesystem::remove(json_path);
+    std::filesystem::remove(binary_path);
+    std::filesystem::remove(converted_path);
+    return 0;
+}
+
+// Measured (g++ 12 -O2, 20M Teslas = 120M events, 1-core VM):
+//   no report                       ~1.2 ns / object
+//   trace compiled in, disabled     ~3.0 ns / object    6 checks of the flag: ~0.3 ns each
+//   trace enabled                   ~170 ns / object    ~28 ns / event, most of it rdtsc (~20 ns in this VM)
+//   cout << endl, to /dev/null      ~2400 ns / object   (to a terminal: far more)
+//   -DLIFECYCLE_TRACE=0             same as no report
@@ -6,6 +6,8 @@
 #include <iostream>
 using namespace std;
 
+#include "../04_inheritance/layout_report.h"
+
 // ============================================================
 // PART 1: WHY DOES vptr EXIST?
 // ============================================================
@@ -63,13 +65,15 @@ public:
 // ============================================================
 
 class NoVirtual {
+public:
     int x;       // 4 bytes
     int y;       // 4 bytes
 };
 // sizeof = 8 — no vptr, no overhead
 
 class OneVirtual {
-    virtual void f();   // triggers vptr injection
+public:
+    virtual void f() {}   // triggers vptr injection
     int x;              // 4 bytes
 };
 // Layout:
@@ -79,8 +83,9 @@ class OneVirtual {
 // sizeof = 16
 
 class TwoVirtuals {
-    virtual void f();
-    virtual void g();   // DOES NOT add another vptr
+public:
+    virtual void f() {}
+    virtual void g() {}   // DOES NOT add another vptr
     int x;
 };
 // Layout:
@@ -93,10 +98,11 @@ class TwoVirtuals {
 // More virtual functions = bigger vtable, NOT more vptrs.
 
 class TenVirtuals {
-    virtual void a(); virtual void b(); virtual void c();
-    virtual void d(); virtual void e(); virtual void f();
-    virtual void g(); virtual void h(); virtual void i();
-    virtual void j();
+public:
+    virtual void a() {} virtual void b() {} virtual void c() {}
+    virtual void d() {} virtual void e() {} virtual void f() {}
+    virtual void g() {} virtual void h() {} virtual void i() {}
+    virtual void j() {}
     int x;
 };
 // sizeof = 16 — still! one vptr regardless of how many virtuals
@@ -126,10 +132,11 @@ public:
 // Layout:
 //   [ vptr        ] 8  -> Derived's vtable: [&Derived::speak, &Base::identify]
 //   [ base_data   ] 4  <- inherited from Base
-//   [ padding     ] 4
-//   [ derived_data] 4
-//   [ padding     ] 4
-// sizeof = 24
+//   [ derived_data] 4  <- placed in Base's tail padding
+// sizeof = 16
+//
+// (Itanium ABI, GCC/Clang: a polymorphic base is not "POD for layout",
+//  so the derived class may reuse its tail padding. MSVC doesn't: 24 there.)
 //
 // IMPORTANT:
 // Derived does NOT get a NEW vptr.
@@ -185,16 +192,36 @@ public:
 //   [ padding ] 4
 //   [ vptr_B  ] 8  -> C's vtable for B-part: [&C::fb]
 //   [ b_data  ] 4
-//   [ padding ] 4
-//   [ c_data  ] 4
-//   [ padding ] 4
-// sizeof = 40
+//   [ c_data  ] 4  <- in B's tail padding (as in Derived above)
+// sizeof = 32
 //
 // TWO vptrs because C inherits from TWO unrelated bases.
 // Each base introduced its own vptr, and C carries both.
 // When you cast C* to B*, the pointer shifts to the B-subobject,
 // so B's vptr is correctly accessible from there.
 
+// ============================================================
+// LAYOUT BUDGETS: the sizes above, checked by the compiler
+// (layout_report.h: the build fails if a class outgrows its budget,
+//  print_layout_report() at the end of main shows the object maps)
+//
+//            class         size  overhead (hidden pointers + padding)
+// ============================================================
+
+LAYOUT_REPORT(AnimalStatic,    4,  0, LAYOUT_FIELD(age));
+LAYOUT_REPORT(DogStatic,       4,  0, LAYOUT_FIELD(age));
+LAYOUT_REPORT(Animal,         16, 12, LAYOUT_FIELD(age));
+LAYOUT_REPORT(Dog,            16, 12, LAYOUT_FIELD(age));
+LAYOUT_REPORT(NoVirtual,       8,  0, LAYOUT_FIELD(x), LAYOUT_FIELD(y));
+LAYOUT_REPORT(OneVirtual,     16, 12, LAYOUT_FIELD(x));
+LAYOUT_REPORT(TwoVirtuals,    16, 12, LAYOUT_FIELD(x));
+LAYOUT_REPORT(TenVirtuals,    16, 12, LAYOUT_FIELD(x));
+LAYOUT_REPORT(Base,           16, 12, LAYOUT_FIELD(base_data));
+LAYOUT_REPORT(Derived,        16,  8, LAYOUT_FIELD(base_data), LAYOUT_FIELD(derived_data));
+LAYOUT_REPORT(A,              16, 12, LAYOUT_FIELD(a_data));
+LAYOUT_REPORT(B,              16, 12, LAYOUT_FIELD(b_data));
+LAYOUT_REPORT(C,              32, 20, LAYOUT_FIELD(a_data), LAYOUT_FIELD(b_data), LAYOUT_FIELD(c_data));
+
 // ============================================================
 // PART 7: VERIFY EVERYTHING WITH sizeof
 // ============================================================
@@ -208,12 +235,12 @@ int main() {
 
     cout << "\n=== PART 4: Inheritance sizes ===\n";
     cout << "Base:    " << sizeof(Base)    << "\n";  // 16
-    cout << "Derived: " << sizeof(Derived) << "\n";  // 24
+    cout << "Derived: " << sizeof(Derived) << "\n";  // 16 — derived_data fills Base's padding
 
     cout << "\n=== PART 6: Multiple inheritance sizes ===\n";
     cout << "A: " << sizeof(A) << "\n";  // 16
     cout << "B: " << sizeof(B) << "\n";  // 16
-    cout << "C: " << sizeof(C) << "\n";  // 40
+    cout << "C: " << sizeof(C) << "\n";  // 32
 
     cout << "\n=== PART 1: Static vs virtual dispatch ===\n";
     AnimalStatic* s = new DogStatic();
@@ -234,6 +261,9 @@ int main() {
     ap->fa();  // C::fa
     bp->fb();  // C::fb
 
+    cout << "\n=== Layout report ===\n";
+    print_layout_report(cout);
+
     return 0;
 }
 
@@ -0,0 +1,292 @@
+// per-call-site virtual dispatch profiling: which concrete types reach a call site, how often, at what cost
+// opt-in: PROFILED_CALL(ptr, print()) is a plain ptr->print() unless built with -DDISPATCH_PROFILE=1
+
+#pragma once
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include <cxxabi.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+// A profiler shows time in Car::print(); this shows which types reach each v->print(), which is what decides
+// whether a call site can be devirtualized (a type check + a direct call):
+//   monomorphic   one receiver type       -- guard on it (guarded_dispatch.h)
+//   bimorphic     two                     -- two guards may still pay
+//   megamorphic   three or more           -- keep the virtual call (or restructure: fleet_container.h)
+//
+// PROFILED_CALL(v, print()) instead of v->print(): each call site gets a static DispatchSite with a small
+// histogram, receiver type -> calls, sampled TSC ticks. Per call: typeid(*v), a scan of the site's type slots,
+// an increment of this thread's own counter (no shared cache line, no locked instruction); one call in
+// kSampleEvery per thread is timed with rdtsc (minus rdtsc's own cost). The per-thread counts are summed
+// when the profile is collected.
+// A site tracks kMaxTypes types; calls from further types count as "other" (and make it megamorphic).
+//
+// print_dispatch_profile(cout) -- every site, busiest first; collect_dispatch_profile() -- the same as data
+
+#ifndef DISPATCH_PROFILE
+#define DISPATCH_PROFILE 0
+#endif
+
+enum class DispatchShape { Monomorphic, Bimorphic, Megamorphic };
+
+struct DispatchTypeStats {
+    const std::type_info *type;
+    std::string name;               // demangled
+    std::uint64_t calls;
+    double ticks_per_call;          // from the sampled calls; 0 if none was sampled
+};
+
+struct DispatchSiteStats {
+    std::string expression;         // "v->print()"
+    std::string file;
+    int line;
+    std::uint64_t calls;
+    std::uint64_t other_calls;      // from types beyond the kMaxTypes tracked
+    DispatchShape shape;
+    std::vector<DispatchTypeStats> types;   // most frequent first
+};
+
+constexpr const char* dispatch_shape_name(DispatchShape shape) {
+    switch(shape) {
+        case DispatchShape::Monomorphic: return "monomorphic";
+        case DispatchShape::Bimorphic:   return "bimorphic";
+        case DispatchShape::Megamorphic: return "megamorphic";
+    }
+    return "?";
+}
+
+namespace dispatch_profile_detail {
+
+constexpr std::size_t kMaxTypes = 8;
+constexpr std::uint32_t kSampleEvery = 64;
+
+inline std::uint64_t read_ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// what a back-to-back pair of read_ticks() measures: subtracted from every sample
+inline std::uint64_t timer_overhead() {
+    static const std::uint64_t overhead = [] {
+        std::uint64_t best = UINT64_MAX;
+        for(int i = 0; i < 1000; i++) {
+            const std::uint64_t start = read_ticks();
+            best = std::min(best, read_ticks() - start);
+        }
+        return best;
+    }();
+    return overhead;
+}
+
+inline std::string demangle(const char *name) {
+    int status = 0;
+    std::unique_ptr<char, void (*)(void*)> readable(abi::__cxa_demangle(name, nullptr, nullptr, &status), std::free);
+    return status == 0 ? std::string(readable.get()) : std::string(name);
+}
+
+// one thread's counts at one site. Only that thread writes them, so an increment is a relaxed load + store
+// (a plain add, not a locked read-modify-write); stats() may read them from any thread meanwhile.
+struct ThreadCounts {
+    std::atomic<std::uint64_t> calls[kMaxTypes]{};
+    std::atomic<std::uint64_t> sampled_calls[kMaxTypes]{};
+    std::atomic<std::uint64_t> sampled_ticks[kMaxTypes]{};
+    std::atomic<std::uint64_t> other_calls{0};
+};
+
+inline void bump(std::atomic<std::uint64_t> &counter, std::uint64_t by = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+}
+
+class DispatchSite;
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<DispatchSite*> sites;   // static objects: they outlive every report taken in main
+};
+
+inline Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+class DispatchSite {
+
+public:
+    DispatchSite(const char *expression, const char *file, int line) : expression_(expression), file_(file), line_(line) {
+        Registry &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.sites.push_back(this);
+    }
+
+    DispatchSite(const DispatchSite&) = delete;
+    DispatchSite& operator=(const DispatchSite&) = delete;
+
+    // the slot index of this receiver type (claimed on its first call); -1 once all slots are taken
+    int slot_of(const std::type_info &type) {
+        for(int i = 0; i < static_cast<int>(kMaxTypes); i++) {
+            const std::type_info *seen = types_[i].load(std::memory_order_acquire);
+            if(seen == nullptr) {
+                // free slot: claim it -- or, if another thread just did, see whose it is now
+                if(types_[i].compare_exchange_strong(seen, &type, std::memory_order_acq_rel) || seen == &type)
+                    return i;
+                continue;
+            }
+            if(seen == &type)
+                return i;
+        }
+        return -1;
+    }
+
+    // the calling thread's counters at this site; PROFILED_CALL caches the reference in a thread_local,
+    // so this (and its lock) runs once per thread per site. Blocks outlive their thread: its counts still add up.
+    ThreadCounts& thread_counts() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return *counts_.emplace_back(std::make_unique<ThreadCounts>());
+    }
+
+    DispatchSiteStats stats() const {
+        DispatchSiteStats s{expression_, file_, line_, 0, 0, DispatchShape::Monomorphic, {}};
+        std::lock_guard<std::mutex> lock(mutex_);
+        for(const std::unique_ptr<ThreadCounts> &counts : counts_)
+            s.other_calls += counts->other_calls.load(std::memory_order_relaxed);
+        for(std::size_t i = 0; i < kMaxTypes; i++) {
+            const std::type_info *type = types_[i].load(std::memory_order_acquire);
+            if(type == nullptr)
+                break;
+            std::uint64_t calls = 0, sampled = 0, ticks = 0;
+            for(const std::unique_ptr<ThreadCounts> &counts : counts_) {
+                calls += counts->calls[i].load(std::memory_order_relaxed);
+                sampled += counts->sampled_calls[i].load(std::memory_order_relaxed);
+                ticks += counts->sampled_ticks[i].load(std::memory_order_relaxed);
+            }
+            const double ticks_per_call = sampled == 0 ? 0.0 : static_cast<double>(ticks) / static_cast<double>(sampled);
+            s.types.push_back(DispatchTypeStats{type, demangle(type->name()), calls, ticks_per_call});
+            s.calls += calls;
+        }
+        s.calls += s.other_calls;
+        std::stable_sort(s.types.begin(), s.types.end(),
+                         [](const DispatchTypeStats &a, const DispatchTypeStats &b) { return a.calls > b.calls; });
+        if(s.other_calls != 0 || s.types.size() > 2)
+            s.shape = DispatchShape::Megamorphic;
+        else if(s.types.size() == 2)
+            s.shape = DispatchShape::Bimorphic;
+        return s;
+    }
+
+private:
+    const char *expression_;
+    const char *file_;
+    int line_;
+    std::atomic<const std::type_info*> types_[kMaxTypes]{};
+    mutable std::mutex mutex_;                              // guards counts_
+    std::vector<std::unique_ptr<ThreadCounts>> counts_;     // one block per thread that has called this site
+};
+
+// one profiled call: counts it on construction, and for the sampled calls, times it until destruction
+class ProfiledCall {
+
+public:
+    ProfiledCall(ThreadCounts &counts, int slot) : counts_(counts), slot_(slot) {
+        if(slot_ < 0) {
+            bump(counts_.other_calls);
+            return;   // an uncounted type (no slot left): never sampled
+        }
+        bump(counts_.calls[slot_]);
+        thread_local std::uint32_t countdown = kSampleEvery;
+        if(--countdown == 0) [[unlikely]] {
+            countdown = kSampleEvery;
+            start_ = read_ticks();
+        }
+    }
+
+    ~ProfiledCall() {
+        if(start_ != 0) [[unlikely]] {
+            const std::uint64_t elapsed = read_ticks() - start_;
+            const std::uint64_t overhead = timer_overhead();
+            bump(counts_.sampled_calls[slot_]);
+            bump(counts_.sampled_ticks[slot_], elapsed > overhead ? elapsed - overhead : 0);
+        }
+    }
+
+    ProfiledCall(const ProfiledCall&) = delete;
+    ProfiledCall& operator=(const ProfiledCall&) = delete;
+
+private:
+    ThreadCounts &counts_;
+    int slot_;
+    std::uint64_t start_ = 0;
+};
+
+}   // namespace dispatch_profile_detail
+
+
+#if DISPATCH_PROFILE
+// receiver: a pointer to a polymorphic object (evaluated once); call: the member call, as after "->"
+#define PROFILED_CALL(receiver, call)                                                                   \
+    [&](auto *dispatch_receiver_) -> decltype(auto) {                                                   \
+        static dispatch_profile_detail::DispatchSite dispatch_site_(#receiver "->" #call, __FILE__, __LINE__); \
+        thread_local dispatch_profile_detail::ThreadCounts &dispatch_counts_ = dispatch_site_.thread_counts(); \
+        const dispatch_profile_detail::ProfiledCall dispatch_call_(dispatch_counts_,                    \
+                                                                   dispatch_site_.slot_of(typeid(*dispatch_receiver_))); \
+        return dispatch_receiver_->call;                                                                \
+    }(receiver)
+#else
+#define PROFILED_CALL(receiver, call) ((receiver)->call)
+#endif
+
+// every site that has been called, busiest first
+inline std::vector<DispatchSiteStats> collect_dispatch_profile() {
+    dispatch_profile_detail::Registry &r = dispatch_profile_detail::registry();
+    std::vector<DispatchSiteStats> sites;
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for(const dispatch_profile_detail::DispatchSite *site : r.sites)
+            sites.push_back(site->stats());
+    }
+    std::stable_sort(sites.begin(), sites.end(),
+                     [](const DispatchSiteStats &a, const DispatchSiteStats &b) { return a.calls > b.calls; });
+    return sites;
+}
+
+// nothing when built without -DDISPATCH_PROFILE=1 (no sites)
+inline void print_dispatch_profile(std::ostream &os) {
+    const std::ios_base::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+    for(const DispatchSiteStats &site : collect_dispatch_profile()) {
+        std::string file = site.file;
+        if(const std::size_t slash = file.rfind('/'); slash != std::string::npos)
+            file.erase(0, slash + 1);
+        os << file << ':' << site.line << "  " << site.expression << "  " << site.calls << " calls, "
+           << dispatch_shape_name(site.shape) << '\n';
+        for(const DispatchTypeStats &type : site.types) {
+            os << "    " << std::left << std::setw(20) << type.name << std::right << std::setw(12) << type.calls
+               << "  " << std::fixed << std::setprecision(1) << std::setw(5)
+               << 100.0 * static_cast<double>(type.calls) / static_cast<double>(site.calls) << "%";
+            if(type.ticks_per_call > 0)
+                os << "  " << std::setprecision(1) << type.ticks_per_call << " ticks / call";
+            os << '\n';
+        }
+        if(site.other_calls != 0)
+            os << "    " << std::left << std::setw(20) << "(other types)" << std::right << std::setw(12)
+               << site.other_calls << '\n';
+        os.flags(flags);
+        os.precision(precision);
+    }
+}
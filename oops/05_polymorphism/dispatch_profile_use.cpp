@@ -0,0 +1,112 @@
+// build: g++ -std=c++20 -O2 -DDISPATCH_PROFILE=1 dispatch_profile_use.cpp
+// usage: ./a.out [vehicles]        (default 10M)
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "../01_basics/timing.h"
+#include "dispatch_profile.h"
+#include "vehicle.h"
+
+// n vehicles: share_car of them Cars, share_tesla Teslas, the rest plain Vehicles, shuffled
+std::vector<std::unique_ptr<Vehicle>> make_fleet(std::size_t n, double share_car, double share_tesla) {
+    std::vector<std::unique_ptr<Vehicle>> fleet;
+    fleet.reserve(n);
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> pick(0.0, 1.0);
+    for(std::size_t i = 0; i < n; i++) {
+        const double p = pick(rng);
+        if(p < share_car)
+            fleet.push_back(std::make_unique<Car>());
+        else if(p < share_car + share_tesla)
+            fleet.push_back(std::make_unique<Tesla>());
+        else
+            fleet.push_back(std::make_unique<Vehicle>());
+    }
+    return fleet;
+}
+
+// three call sites, each in its own function: one site per PROFILED_CALL in the source
+double range_of_cars(const std::vector<std::unique_ptr<Vehicle>> &fleet) {
+    double total = 0;
+    for(const auto &v : fleet)
+        total += PROFILED_CALL(v.get(), range_km());
+    return total;
+}
+
+double range_of_car_mix(const std::vector<std::unique_ptr<Vehicle>> &fleet) {
+    double total = 0;
+    for(const auto &v : fleet)
+        total += PROFILED_CALL(v.get(), range_km());
+    return total;
+}
+
+int tyres_of_everything(const std::vector<std::unique_ptr<Vehicle>> &fleet) {
+    int total = 0;
+    for(const auto &v : fleet)
+        total += PROFILED_CALL(v.get(), tyre_count());
+    return total;
+}
+
+double range_plain(const std::vector<std::unique_ptr<Vehicle>> &fleet) {
+    double total = 0;
+    for(const auto &v : fleet)
+        total += v->range_km();
+    return total;
+}
+
+int main(int argc, char **argv) {
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+
+    const auto cars = make_fleet(n / 10, 1.0, 0.0);
+    const auto car_mix = make_fleet(n / 10, 0.9, 0.1);
+    const auto everything = make_fleet(n / 10, 0.5, 0.3);
+    double sink = range_of_cars(cars) + range_of_car_mix(car_mix) + tyres_of_everything(everything);
+
+    print_dispatch_profile(std::cout);
+    // dispatch_profile_use.cpp:36  v.get()->range_km()  1000000 calls, monomorphic
+    //     Car                      1000000  100.0%  12.7 ticks / call
+    // dispatch_profile_use.cpp:43  v.get()->range_km()  1000000 calls, bimorphic
+    //     Car                       900144   90.0%  9.6 ticks / call
+    //     Tesla                      99856   10.0%  9.3 ticks / call
+    // dispatch_profile_use.cpp:50  v.get()->tyre_count()  1000000 calls, megamorphic
+    //     Car                       499280   49.9%  11.5 ticks / call
+    //     Tesla                     300559   30.1%  10.7 ticks / call
+    //     Vehicle                   200161   20.0%  10.5 ticks / call
+
+    // profile data -> where a type guard would pay: one type takes (nearly) every call
+    for(const DispatchSiteStats &site : collect_dispatch_profile()) {
+        const DispatchTypeStats &top = site.types.front();
+        const double share = static_cast<double>(top.calls) / static_cast<double>(site.calls);
+        if(share >= 0.9)
+            std::cout << "candidate: line " << site.line << ", expect " << top.name << " (" << share * 100 << "%)\n";
+    }
+    // candidate: line 36, expect Car (100%)
+    // candidate: line 43, expect Car (90.0144%)
+
+
+    // ------------------------------------------------------------
+    // Benchmark: the cost of profiling, same loop with and without PROFILED_CALL
+    // ------------------------------------------------------------
+    const auto fleet = make_fleet(n, 0.5, 0.3);
+    double plain = 0, profiled = 0;
+    range_plain(fleet);   // warm up
+    const double plain_ms = time_ms([&] { plain = range_plain(fleet); });
+    const double profiled_ms = time_ms([&] { profiled = range_of_car_mix(fleet); });
+    sink += plain + profiled;
+    std::cout << "plain v->range_km():   " << plain_ms * 1e6 / static_cast<double>(n) << " ns / call\n";
+    std::cout << "PROFILED_CALL:         " << profiled_ms * 1e6 / static_cast<double>(n) << " ns / call"
+              << (plain == profiled ? "" : "  MISMATCH") << '\n';
+    std::cout << "(sink " << sink << ")\n";
+    return 0;
+}
+
+// Measured (g++ 12 -O2, 1-core VM, range_km() over a shuffled 50% Car / 30% Tesla / 20% Vehicle fleet):
+//   10M vehicles:    plain ~15 ns / call    PROFILED_CALL ~21 ns / call
+//   built without -DDISPATCH_PROFILE=1: the same loop, the same ~15 ns
+// So ~6 ns per call: the typeid load, the slot scan, this thread's counter, and a sampled rdtsc pair.
+// The counts used to be one shared atomic per type, bumped with a locked fetch_add: ~2 ns more here,
+// and far more on a multi-core machine where several threads hit the same site (the line ping-pongs).
@@ -0,0 +1,124 @@
+// a fleet of Vehicles stored by exact type: one contiguous array per class, no per-element virtual dispatch
+// the objects are still ordinary polymorphic Vehicles -- Vehicle& / Vehicle* and virtual calls keep working
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "vehicle.h"
+
+// for(Vehicle *v : fleet) total += v->tyre_count();  loads a pointer, a separately allocated object, its vptr
+// and a slot, then makes an indirect call that a mixed fleet mispredicts and nothing can inline.
+// Here the type is known by WHERE the object is, one vector per exact type:
+//   vehicles_ : [ Vehicle | Vehicle | ... ]
+//   cars_     : [ Car | Car | ... ]
+//   teslas_   : [ Tesla | Tesla | ... ]
+// and each partition is processed with a statically bound call: v.Car::tyre_count() is a qualified call,
+// never dispatched virtually (Tesla is final, so t.tyre_count() is static too), and gets inlined.
+//
+// Iteration is by type, not insertion order; only these three exact types fit (a class derived from Car
+// would be sliced in cars_). Element addresses are stable only until the next emplace into the same partition.
+
+class FleetContainer {
+
+private:
+    std::vector<Vehicle> vehicles_;
+    std::vector<Car> cars_;
+    std::vector<Tesla> teslas_;
+
+    template <typename T>
+    static constexpr bool is_fleet_type = std::is_same_v<T, Vehicle> || std::is_same_v<T, Car> || std::is_same_v<T, Tesla>;
+
+public:
+    FleetContainer() = default;
+
+    // the partition holding exactly T
+    template <typename T>
+    std::vector<T>& partition() {
+        static_assert(is_fleet_type<T>, "FleetContainer stores exactly Vehicle, Car or Tesla");
+        if constexpr(std::is_same_v<T, Vehicle>)
+            return vehicles_;
+        else if constexpr(std::is_same_v<T, Car>)
+            return cars_;
+        else
+            return teslas_;
+    }
+
+    template <typename T>
+    const std::vector<T>& partition() const {
+        return const_cast<FleetContainer&>(*this).partition<T>();
+    }
+
+    template <typename T, typename... Args>
+    T& emplace(Args&&... args) {
+        return partition<T>().emplace_back(std::forward<Args>(args)...);
+    }
+
+    void reserve(std::size_t vehicles, std::size_t cars, std::size_t teslas) {
+        vehicles_.reserve(vehicles);
+        cars_.reserve(cars);
+        teslas_.reserve(teslas);
+    }
+
+    std::size_t size() const {
+        return vehicles_.size() + cars_.size() + teslas_.size();
+    }
+
+    // f(Vehicle&), then f(Car&) for every Car, then f(Tesla&) -- f sees each object's exact static type
+    // (a generic lambda gets one instantiation per partition; call members qualified, e.g. car.Car::print(),
+    //  for Vehicle and Car -- Tesla is final, so its calls are static anyway)
+    template <typename F>
+    void for_each(F &&f) {
+        for(Vehicle &v : vehicles_)
+            f(v);
+        for(Car &c : cars_)
+            f(c);
+        for(Tesla &t : teslas_)
+            f(t);
+    }
+
+    template <typename F>
+    void for_each(F &&f) const {
+        for(const Vehicle &v : vehicles_)
+            f(v);
+        for(const Car &c : cars_)
+            f(c);
+        for(const Tesla &t : teslas_)
+            f(t);
+    }
+
+    // same answers as the virtual calls on every element, without the dispatch
+    long long total_tyres() const {
+        long long total = 0;
+        for(const Vehicle &v : vehicles_)
+            total += v.Vehicle::tyre_count();
+        for(const Car &c : cars_)
+            total += c.Car::tyre_count();
+        for(const Tesla &t : teslas_)
+            total += t.tyre_count();
+        return total;
+    }
+
+    double total_range_km() const {
+        double total = 0;
+        for(const Vehicle &v : vehicles_)
+            total += v.Vehicle::range_km();
+        for(const Car &c : cars_)
+            total += c.Car::range_km();
+        for(const Tesla &t : teslas_)
+            total += t.range_km();
+        return total;
+    }
+
+    void print_all() const {
+        for(const Vehicle &v : vehicles_)
+            v.Vehicle::print();
+        for(const Car &c : cars_)
+            c.Car::print();
+        for(const Tesla &t : teslas_)
+            t.print();
+    }
+};
@@ -0,0 +1,125 @@
+// build: g++ -std=c++20 -O2 fleet_container_use.cpp
+// usage: ./a.out [vehicles]        (default 10M, ~1 GB for both fleets)
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <typeinfo>
+#include <vector>
+
+#include "../01_basics/timing.h"
+#include "fleet_container.h"
+#include "vehicle.h"
+
+long long virtual_tyres(const std::vector<Vehicle*> &fleet) {
+    long long total = 0;
+    for(const Vehicle *v : fleet)
+        total += v->tyre_count();
+    return total;
+}
+
+double virtual_range(const std::vector<Vehicle*> &fleet) {
+    double total = 0;
+    for(const Vehicle *v : fleet)
+        total += v->range_km();
+    return total;
+}
+
+int main(int argc, char **argv) {
+    FleetContainer fleet;
+    fleet.emplace<Vehicle>();
+    Car &car = fleet.emplace<Car>();
+    fleet.emplace<Tesla>();
+    fleet.print_all();
+    // Vehicle
+    // Car
+    // Tesla
+
+    // still polymorphic objects: the virtual API works as in 05_02
+    Vehicle &v = car;
+    v.print();                                   // Output : Car
+    v.num_tyres();                               // Output : 4
+    fleet.partition<Vehicle>()[0].num_tyres();   // Output : Unknown
+    std::cout << fleet.total_tyres() << std::endl;   // 8
+
+    int cars = 0;
+    fleet.for_each([&](const auto &vehicle) {
+        if constexpr(std::is_same_v<std::decay_t<decltype(vehicle)>, Car>)
+            cars++;
+    });
+    std::cout << cars << " car" << std::endl;    // 1 car
+
+    // ------------------------------------------------------------
+    // Benchmark: total tyres of a mixed fleet
+    // ------------------------------------------------------------
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> kind(0, 2), litres(10, 60), battery(40, 100);
+
+    std::vector<std::unique_ptr<Vehicle>> owned;
+    owned.reserve(n);
+    FleetContainer big;
+    big.reserve(n / 2, n / 2, n / 2);
+    for(std::size_t i = 0; i < n; i++) {
+        switch(kind(rng)) {
+            case 0: owned.push_back(std::make_unique<Vehicle>()); big.emplace<Vehicle>(); break;
+            case 1: {
+                Car &c = big.emplace<Car>();
+                c.fuelLitres = litres(rng);   // whole numbers: the sums are exact in any order
+                owned.push_back(std::make_unique<Car>(c));
+                break;
+            }
+            default: {
+                Tesla &t = big.emplace<Tesla>();
+                t.batteryKwh = battery(rng);
+                owned.push_back(std::make_unique<Tesla>(t));
+                break;
+            }
+        }
+    }
+    std::vector<Vehicle*> pointers;
+    pointers.reserve(n);
+    for(const auto &p : owned)
+        pointers.push_back(p.get());
+
+    // the same pointers grouped by type: the indirect branch becomes predictable, the rest stays
+    std::vector<Vehicle*> grouped = pointers;
+    std::stable_sort(grouped.begin(), grouped.end(), [](const Vehicle *a, const Vehicle *b) {
+        return typeid(*a).before(typeid(*b));
+    });
+
+    long long mixed_tyres = 0, grouped_tyres = 0, fleet_tyres = 0;
+    const double mixed_tyres_ms = time_ms([&] { mixed_tyres = virtual_tyres(pointers); });
+    const double grouped_tyres_ms = time_ms([&] { grouped_tyres = virtual_tyres(grouped); });
+    const double fleet_tyres_ms = time_ms([&] { fleet_tyres = big.total_tyres(); });
+
+    double mixed_range = 0, grouped_range = 0, fleet_range = 0;
+    const double mixed_range_ms = time_ms([&] { mixed_range = virtual_range(pointers); });
+    const double grouped_range_ms = time_ms([&] { grouped_range = virtual_range(grouped); });
+    const double fleet_range_ms = time_ms([&] { fleet_range = big.total_range_km(); });
+
+    std::cout << n << " vehicles, " << big.partition<Vehicle>().size() << " / " << big.partition<Car>().size()
+              << " / " << big.partition<Tesla>().size() << "\n";
+    std::cout << "tyre_count()                       total: " << fleet_tyres << "\n";
+    std::cout << "  vector<Vehicle*>, mixed order:     " << mixed_tyres_ms << " ms\n";
+    std::cout << "  vector<Vehicle*>, grouped by type: " << grouped_tyres_ms << " ms\n";
+    std::cout << "  FleetContainer::total_tyres:       " << fleet_tyres_ms << " ms"
+              << ", same total: " << (mixed_tyres == fleet_tyres && grouped_tyres == fleet_tyres) << "\n";
+    std::cout << "range_km()                         total: " << fleet_range << "\n";
+    std::cout << "  vector<Vehicle*>, mixed order:     " << mixed_range_ms << " ms\n";
+    std::cout << "  vector<Vehicle*>, grouped by type: " << grouped_range_ms << " ms\n";
+    std::cout << "  FleetContainer::total_range_km:    " << fleet_range_ms << " ms, " << mixed_range_ms / fleet_range_ms << "x"
+              << ", same total: " << (mixed_range == fleet_range && grouped_range == fleet_range) << "\n";
+
+    // measured (10M vehicles, -O2):
+    //   tyre_count:  pointers, mixed ~145 ms   grouped ~105 ms   FleetContainer ~0 ms
+    //                (statically bound and inlined, each partition's sum folds to size() * 4)
+    //   range_km:    pointers, mixed ~150 ms   grouped ~125 ms   FleetContainer ~46 ms (~3.3x)
+    // grouping the pointers only fixes the branch prediction; the indirect call, the pointer chase
+    // and the lost inlining remain. (The heap objects here were allocated in order, so they are
+    // nearly contiguous -- in a long-running program they usually aren't, and the gap widens.)
+
+    return 0;
+}
@@ -0,0 +1,154 @@
+// guarded speculative devirtualization: check the receiver's vptr against the expected concrete type(s),
+// make a direct (inlinable) call on a match, the ordinary virtual call otherwise
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+#include "dispatch_profile.h"
+
+// v->range_km() through Vehicle* is an indirect call the compiler can't inline. When the profile says the site
+// almost always sees a Car (dispatch_profile.h: monomorphic), check for that first:
+//
+//   GuardedCall<Vehicle, Car> site;                     // the expected types, most likely first
+//   total += site(v, DEVIRTUALIZED(range_km()));
+//
+//   if(vptr(v) == Car's vptr)  static_cast<Car*>(v)->Car::range_km()    qualified: a direct call, inlined
+//   else                       v->range_km()                            the virtual call, as before
+//
+// (GCC's -fdevirtualize-speculatively does this with profile feedback.) A hit saves the indirect call, a miss
+// pays a compare first: it pays on skewed sites and costs on uniform ones (guarded_dispatch_use.cpp).
+//
+// The vtable has no name in the language, so each guard learns the vptr: the first receiver whose typeid is
+// exactly the candidate's gives it. A match then means the object IS a Car, not a class derived from it
+// (Itanium ABI: the vptr is an object's first word). A candidate that hasn't come by in kMaxLearnMisses calls
+// is taken to be absent and its guard disarms itself, instead of checking typeid on every call.
+// Which candidates are armed is run-time: arm_from_profile() arms those with at least min_share of the
+// profiled calls and disarms the rest -- a disarmed guard never matches.
+
+namespace guarded_dispatch_detail {
+
+template <typename Base>
+const void* vptr_of(const Base *receiver) {
+    const void *vptr;
+    std::memcpy(&vptr, receiver, sizeof(vptr));
+    return vptr;
+}
+
+}   // namespace guarded_dispatch_detail
+
+
+template <typename Base, typename... Candidates>
+class GuardedCall {
+    static_assert(std::is_polymorphic_v<Base>, "guards read the vptr: Base must be polymorphic");
+    static_assert((std::is_base_of_v<Base, Candidates> && ...), "every candidate must derive from Base");
+    static_assert(sizeof...(Candidates) > 0, "at least one expected type");
+
+public:
+    static constexpr std::uint32_t kMaxLearnMisses = 4096;   // calls without the candidate before it's given up
+
+    GuardedCall() = default;
+
+    GuardedCall(const GuardedCall&) = delete;
+    GuardedCall& operator=(const GuardedCall&) = delete;
+
+    // call: DEVIRTUALIZED(method(args...)) -- given a Candidate*, a direct call; given the Base*, a virtual one
+    template <typename B, typename F>
+    decltype(auto) operator()(B *receiver, F &&call) const {
+        static_assert(std::is_same_v<std::remove_const_t<B>, Base>, "the receiver is a pointer to Base");
+        return dispatch<0>(receiver, guarded_dispatch_detail::vptr_of(receiver), call);
+    }
+
+    template <typename T>
+    void arm(bool on) {
+        constexpr std::size_t i = index_of<T>();
+        learn_misses_[i].store(0, std::memory_order_relaxed);
+        vptrs_[i].store(on ? nullptr : disarmed(), std::memory_order_relaxed);   // armed: learned again
+    }
+
+    // false once disarmed, by arm(false) or for never showing up while learning
+    template <typename T>
+    bool armed() const {
+        return vptrs_[index_of<T>()].load(std::memory_order_relaxed) != disarmed();
+    }
+
+    // arms the candidates with at least min_share of the site's profiled calls, disarms the others
+    void arm_from_profile(const DispatchSiteStats &site, double min_share = 0.5) {
+        (arm<Candidates>(share_of(site, typeid(Candidates)) >= min_share), ...);
+    }
+
+private:
+    template <typename T, std::size_t I = 0>
+    static constexpr std::size_t index_of() {
+        static_assert(I < sizeof...(Candidates), "not one of the candidates");
+        if constexpr(std::is_same_v<T, std::tuple_element_t<I, std::tuple<Candidates...>>>)
+            return I;
+        else
+            return index_of<T, I + 1>();
+    }
+
+    static double share_of(const DispatchSiteStats &site, const std::type_info &type) {
+        for(const DispatchTypeStats &t : site.types) {
+            if(*t.type == type)
+                return site.calls == 0 ? 0.0 : static_cast<double>(t.calls) / static_cast<double>(site.calls);
+        }
+        return 0.0;
+    }
+
+    template <std::size_t I, typename B, typename F>
+    decltype(auto) dispatch(B *receiver, const void *vptr, F &call) const {
+        if constexpr(I == sizeof...(Candidates)) {
+            return call(receiver, std::false_type{});   // no guard matched: the virtual call
+        }
+        else {
+            using T = std::tuple_element_t<I, std::tuple<Candidates...>>;
+            using Target = std::conditional_t<std::is_const_v<B>, const T, T>;
+            const void *expected = vptrs_[I].load(std::memory_order_relaxed);
+            if(vptr == expected || (expected == nullptr && learn<I, T>(receiver, vptr)))
+                return call(static_cast<Target*>(receiver), std::true_type{});
+            return dispatch<I + 1>(receiver, vptr, call);
+        }
+    }
+
+    // no vptr yet: if this receiver is exactly a T, keep its vptr; after kMaxLearnMisses others, disarm.
+    // Compare-exchanged from nullptr, so neither undoes a concurrent arm(false) (or another thread's learn).
+    template <std::size_t I, typename T>
+    [[gnu::noinline]] bool learn(const Base *receiver, const void *vptr) const {
+        const void *expected = nullptr;
+        if(typeid(*receiver) != typeid(T)) {
+            if(learn_misses_[I].fetch_add(1, std::memory_order_relaxed) + 1 >= kMaxLearnMisses)
+                vptrs_[I].compare_exchange_strong(expected, disarmed(), std::memory_order_relaxed);
+            return false;
+        }
+        return vptrs_[I].compare_exchange_strong(expected, vptr, std::memory_order_relaxed) || expected == vptr;
+    }
+
+    // no object's vptr: what a disarmed guard expects
+    static const void* disarmed() {
+        static const char never_a_vtable = 0;
+        return &never_a_vtable;
+    }
+
+    // per candidate: its vptr once learned, nullptr while learning, disarmed() when disarmed
+    mutable std::array<std::atomic<const void*>, sizeof...(Candidates)> vptrs_{};
+    mutable std::array<std::atomic<std::uint32_t>, sizeof...(Candidates)> learn_misses_{};   // while learning
+};
+
+// the call, for GuardedCall: a direct call (qualified with the candidate's type) when handed a candidate,
+// the ordinary virtual call when handed the Base*. Arguments are captured by reference.
+#define DEVIRTUALIZED(call)                                                                 \
+    [&](auto *guarded_receiver_, auto guarded_exact_) -> decltype(auto) {                   \
+        using GuardedType = std::remove_cv_t<std::remove_pointer_t<decltype(guarded_receiver_)>>; \
+        if constexpr(decltype(guarded_exact_)::value)                                       \
+            return guarded_receiver_->GuardedType::call;                                    \
+        else                                                                                \
+            return guarded_receiver_->call;                                                 \
+    }
@@ -0,0 +1,196 @@
+// build: g++ -std=c++20 -O2 -DDISPATCH_PROFILE=1 guarded_dispatch_use.cpp
+// usage: ./a.out [calls]        (default 8M)
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "../01_basics/timing.h"
+#include "dispatch_profile.h"
+#include "guarded_dispatch.h"
+#include "vehicle.h"
+
+using Fleet = std::vector<std::unique_ptr<Vehicle>>;
+
+// n vehicles: share_car of them Cars, share_tesla Teslas, the rest plain Vehicles, shuffled
+Fleet make_fleet(std::size_t n, double share_car, double share_tesla) {
+    Fleet fleet;
+    fleet.reserve(n);
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> pick(0.0, 1.0);
+    for(std::size_t i = 0; i < n; i++) {
+        const double p = pick(rng);
+        if(p < share_car)
+            fleet.push_back(std::make_unique<Car>());
+        else if(p < share_car + share_tesla)
+            fleet.push_back(std::make_unique<Tesla>());
+        else
+            fleet.push_back(std::make_unique<Vehicle>());
+    }
+    return fleet;
+}
+
+// two more Vehicles that no guard below expects: with plain Vehicle, a uniform mix the guards can only miss
+class Bus : public Vehicle {
+    public:
+        double fuelLitres = 300;
+        double kmPerLitre = 3;
+
+        double range_km() const override {
+            return fuelLitres * kmPerLitre;
+        }
+};
+
+class Truck : public Vehicle {
+    public:
+        double fuelLitres = 400;
+        double kmPerLitre = 2.5;
+
+        double range_km() const override {
+            return fuelLitres * kmPerLitre;
+        }
+};
+
+// n vehicles: a third each Vehicle, Bus, Truck, shuffled -- none of them a Car or a Tesla
+Fleet make_unexpected_fleet(std::size_t n) {
+    Fleet fleet;
+    fleet.reserve(n);
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int> pick(0, 2);
+    for(std::size_t i = 0; i < n; i++) {
+        switch(pick(rng)) {
+            case 0:  fleet.push_back(std::make_unique<Vehicle>()); break;
+            case 1:  fleet.push_back(std::make_unique<Bus>()); break;
+            default: fleet.push_back(std::make_unique<Truck>()); break;
+        }
+    }
+    return fleet;
+}
+
+// n calls: random picks from the fleet -- a type sequence that doesn't repeat, so the branch predictors can't
+// learn it (looping over one small fleet, they do: the uniform mixes then look nearly as cheap as the skewed)
+std::vector<const Vehicle*> pick_calls(const Fleet &fleet, std::size_t n) {
+    std::vector<const Vehicle*> calls(n);
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<std::size_t> pick(0, fleet.size() - 1);
+    for(const Vehicle *&v : calls)
+        v = fleet[pick(rng)].get();
+    return calls;
+}
+
+// the site to be devirtualized, profiled: a sample of its traffic decides what its guards expect
+double range_profiled(const Fleet &fleet) {
+    double total = 0;
+    for(const auto &v : fleet)
+        total += PROFILED_CALL(v.get(), range_km());
+    return total;
+}
+
+// the timed loops stay functions of their own: inlined into main's timing lambdas, GCC kept the running total
+// in memory around the (possible) call -- a store / load per vehicle that timed the spill, not the dispatch
+[[gnu::noinline]] double range_plain(const std::vector<const Vehicle*> &calls) {
+    double total = 0;
+    for(const Vehicle *v : calls)
+        total += v->range_km();
+    return total;
+}
+
+template <typename... Expected>
+[[gnu::noinline]] double range_guarded(const GuardedCall<Vehicle, Expected...> &site,
+                                       const std::vector<const Vehicle*> &calls) {
+    double total = 0;
+    for(const Vehicle *v : calls)
+        total += site(v, DEVIRTUALIZED(range_km()));
+    return total;
+}
+
+int main(int argc, char **argv) {
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 8'000'000;
+    constexpr std::size_t kFleet = 4096;   // ~200 KB of vehicles: cached, so the loop times the dispatch, not DRAM
+
+    // profile data -> configuration: the candidates are compiled in, the profile arms those that are common
+    GuardedCall<Vehicle, Car, Tesla> site;
+    double sink = range_profiled(make_fleet(kFleet, 0.95, 0.04));
+    for(const DispatchSiteStats &stats : collect_dispatch_profile())
+        site.arm_from_profile(stats, 0.5);
+    std::cout << "Car guard " << (site.armed<Car>() ? "armed" : "disarmed") << ", Tesla guard "
+              << (site.armed<Tesla>() ? "armed" : "disarmed") << '\n';
+    // Car guard armed, Tesla guard disarmed        (95% / 4% of the sample)
+    // without -DDISPATCH_PROFILE=1 there is no profile: the guards keep their default, armed
+
+    const Fleet check_fleet = make_fleet(1000, 0.6, 0.3);
+    const std::vector<const Vehicle*> check = pick_calls(check_fleet, 10'000);
+    std::cout << "guarded == virtual: " << (range_guarded(site, check) == range_plain(check) ? "yes" : "NO") << '\n';
+    // guarded == virtual: yes
+
+
+    // ------------------------------------------------------------
+    // Benchmark: range_km() over shuffled fleets, virtual vs guarded, skewed to uniform
+    // ------------------------------------------------------------
+    struct Mix { const char *name; double car, tesla; bool unexpected; };
+    const Mix mixes[] = {
+        {"100% Car                 ", 1.00, 0.00, false},
+        {"95% Car,  5% Tesla       ", 0.95, 0.05, false},
+        {"80% Car, 20% Tesla       ", 0.80, 0.20, false},
+        {"50% Car, 50% Tesla       ", 0.50, 0.50, false},
+        {"1/3 Car, Tesla, Vehicle  ", 1.0 / 3, 1.0 / 3, false},
+        {"1/3 Vehicle, Bus, Truck  ", 0.00, 0.00, true},    // no guard ever matches
+    };
+    // the guards learn their vptrs on a Car + Tesla sample first, as if armed from that profile
+    const Fleet training_fleet = make_fleet(kFleet, 0.5, 0.5);
+    const std::vector<const Vehicle*> training = pick_calls(training_fleet, kFleet);
+    std::cout << "                           virtual   guard Car   guard Car+Tesla   (ns / call)\n";
+    for(const Mix &mix : mixes) {
+        const Fleet fleet = mix.unexpected ? make_unexpected_fleet(kFleet) : make_fleet(kFleet, mix.car, mix.tesla);
+        const std::vector<const Vehicle*> calls = pick_calls(fleet, n);
+        GuardedCall<Vehicle, Car> expect_car;
+        GuardedCall<Vehicle, Car, Tesla> expect_car_tesla;
+        sink += range_guarded(expect_car, training) + range_guarded(expect_car_tesla, training);
+        double plain_ms = 1e30, car_ms = 1e30, both_ms = 1e30;
+        for(int round = 0; round < 3; round++) {   // best of 3
+            plain_ms = std::min(plain_ms, time_ms([&] { sink += range_plain(calls); }));
+            car_ms = std::min(car_ms, time_ms([&] { sink += range_guarded(expect_car, calls); }));
+            both_ms = std::min(both_ms, time_ms([&] { sink += range_guarded(expect_car_tesla, calls); }));
+        }
+        const double per_call = 1e6 / static_cast<double>(n);
+        std::cout << mix.name << "  " << plain_ms * per_call << "     " << car_ms * per_call << "       "
+                  << both_ms * per_call << '\n';
+    }
+
+    // a candidate that never comes: every call misses the guard, until it gives up learning
+    const Fleet cars = make_fleet(kFleet, 1.0, 0.0);
+    const std::vector<const Vehicle*> car_calls = pick_calls(cars, n);
+    GuardedCall<Vehicle, Tesla> expect_tesla;
+    double plain_ms = 1e30, absent_ms = 1e30;
+    for(int round = 0; round < 3; round++) {
+        plain_ms = std::min(plain_ms, time_ms([&] { sink += range_plain(car_calls); }));
+        absent_ms = std::min(absent_ms, time_ms([&] { sink += range_guarded(expect_tesla, car_calls); }));
+    }
+    const double per_call = 1e6 / static_cast<double>(n);
+    std::cout << "100% Car, guard Tesla only: virtual " << plain_ms * per_call << ", guarded " << absent_ms * per_call
+              << " ns / call, Tesla guard " << (expect_tesla.armed<Tesla>() ? "armed" : "disarmed") << '\n';
+    // 100% Car, guard Tesla only: ... Tesla guard disarmed        (after kMaxLearnMisses calls)
+    std::cout << "(sink " << sink << ")\n";
+    return 0;
+}
+
+// Measured (g++ 12 -O2, 1-core VM, 8M calls drawn at random from a 4K-vehicle fleet, best of 3, runs vary ~10%):
+//                              virtual     guard Car     guard Car + Tesla     (ns / call)
+//   100% Car                   ~3.6        ~2.1          ~2.2
+//   95% Car, 5% Tesla          ~3.9        ~2.8          ~2.9
+//   80% Car, 20% Tesla         ~5.8        ~5.0          ~4.7
+//   50% Car, 50% Tesla         ~9.7        ~9.1          ~8.2
+//   1/3 Car, Tesla, Vehicle    ~11.7       ~11.4         ~10.9
+//   1/3 Vehicle, Bus, Truck    ~10.8       ~10.9         ~12.1
+// Skewed: the hit is a compare and the inlined multiply, no indirect call, nothing spilled around it -- ~40% off.
+// 1/3 Car, Tesla, Vehicle: most of the gain is gone, but the guards still come out slightly ahead -- a third of
+// the calls hit, and the indirect call behind a miss only has two targets left to mispredict between.
+// 1/3 Vehicle, Bus, Truck: the adversarial case. No call ever hits, so every guard is pure overhead on top of
+// the same three-way indirect call: ~0.1-0.4 ns for one guard, ~1-2 ns for two. A guard only pays when the type
+// it expects is common. (Looping over one small fleet instead, the predictors learn the sequence and every
+// mix looks cheap: 1/3 each was ~9 ns virtual, ~1.7 ns guarded.)
+// A guard for a type that never comes (Tesla on 100% Car): ~3.5 ns virtual, ~3.6 guarded once it has disarmed
+// itself. While it kept learning forever, every call paid the noinline typeid check as well: ~7.2 ns.
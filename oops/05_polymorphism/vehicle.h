@@ -0,0 +1,76 @@
+// the Vehicle / Car / Tesla hierarchy of 05_02 (Tesla as in 04_01), as a header other code can use
+// same virtual API -- print(), num_tyres() -- plus tyre_count(): the same question, as a value
+
+#pragma once
+
+#include <iostream>
+#include <string>
+
+// num_tyres() prints, which is fine for a demo and useless in a loop over millions of vehicles:
+// tyre_count() answers with an int (0 = unknown, like num_tyres()'s "Unknown").
+// range_km() is one that depends on the object's data (fuel, battery), not only on its type.
+// Destructors are quiet here (05_02's print), so fleets of millions can be built and freed.
+
+class Vehicle {
+    public:
+        std::string color;
+
+        virtual void print() const {
+            std::cout << "Vehicle" << std::endl;
+        }
+
+        virtual void num_tyres() const {
+            const int count = tyre_count();
+            if(count == 0)
+                std::cout << "Unknown" << std::endl;
+            else
+                std::cout << count << std::endl;
+        }
+
+        virtual int tyre_count() const {
+            return 0;
+        }
+
+        virtual double range_km() const {
+            return 0;
+        }
+
+        virtual ~Vehicle() = default;
+};
+
+class Car : public Vehicle {
+    public:
+        int numGears = 5;
+        double fuelLitres = 40;
+        double kmPerLitre = 15;
+
+        void print() const override {
+            std::cout << "Car" << std::endl;
+        }
+
+        int tyre_count() const override {
+            return 4;
+        }
+
+        double range_km() const override {
+            return fuelLitres * kmPerLitre;
+        }
+};
+
+// final: nothing derives from Tesla, so a call through a Tesla& or Tesla* is bound at compile time
+class Tesla final : public Car {
+    public:
+        double batteryKwh = 75;
+
+        void print() const override {
+            std::cout << "Tesla" << std::endl;
+        }
+
+        int tyre_count() const override {
+            return 4;
+        }
+
+        double range_km() const override {
+            return batteryKwh * 6.5;
+        }
+};
@@ -0,0 +1,129 @@
+// the abstract Vehicle / Car / Tesla hierarchy, with static polymorphism instead of virtual functions
+// CRTP for the "abstract class" part, std::variant + std::visit for "one of several concrete types"
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <variant>
+
+// The virtual version (virtual_functions_and_abstract_classes.cpp):
+//   Vehicle: pure virtual print(), print_tyres()   -> abstract
+//   Car:     overrides print()                     -> still abstract
+//   Tesla:   overrides print_tyres()               -> concrete
+// every object carries a vptr (8 bytes, + padding), every call through Vehicle* is an indirect call
+// that the compiler can't inline, and objects of different types can only be kept together through pointers.
+//
+// Here:
+//   StaticVehicle<Derived>   CRTP base: print() calls Derived's print_impl() -- resolved at compile time.
+//                            "Pure virtual" = Derived must provide the _impl function, or it doesn't compile.
+//                            Protected constructor: like the abstract Vehicle, it can't be an object by itself.
+//   StaticCar<Derived>       the Car layer: provides print_impl(), still a template -> still "abstract"
+//   StaticSedan, StaticTesla concrete: provide tyre_count_impl() / range_km_impl()
+//   AnyVehicle               std::variant<StaticSedan, StaticTesla>: a Car-like OR a Tesla, BY VALUE,
+//                            so std::vector<AnyVehicle> is one contiguous array of mixed vehicles.
+//                            std::visit dispatches on the variant's index: a jump table / compare,
+//                            into calls that are statically known -- and inlined.
+//
+// No vptr in any object, no heap allocation per object.
+// The price: the set of types is closed (adding a vehicle means editing AnyVehicle), and
+// StaticVehicle<StaticSedan> and StaticVehicle<StaticTesla> are unrelated types -- there is no common base pointer.
+
+template <typename Derived>
+class StaticVehicle {
+    public:
+        std::string color;
+
+        void print() const {
+            self().print_impl();
+        }
+
+        void print_tyres() const {
+            std::cout << self().tyre_count_impl() << std::endl;
+        }
+
+        int tyre_count() const {
+            return self().tyre_count_impl();
+        }
+
+        double range_km() const {
+            return self().range_km_impl();
+        }
+
+    protected:
+        // only as a base (the "abstract class"); non-virtual destructor: never deleted through StaticVehicle*
+        StaticVehicle() = default;
+        ~StaticVehicle() = default;
+
+    private:
+        const Derived& self() const {
+            return static_cast<const Derived&>(*this);
+        }
+};
+
+template <typename Derived>
+class StaticCar : public StaticVehicle<Derived> {
+    public:
+        int numGears = 5;
+
+        void print_impl() const {
+            std::cout << "Car" << std::endl;
+        }
+
+    protected:
+        StaticCar() = default;
+        ~StaticCar() = default;
+};
+
+// the Car-like concrete type: a plain fuel car
+class StaticSedan final : public StaticCar<StaticSedan> {
+    public:
+        // user-declared: keeps StaticSedan{} from being aggregate init, which would touch the protected bases
+        StaticSedan() = default;
+
+        double fuelLitres = 40;
+        double kmPerLitre = 15;
+
+        int tyre_count_impl() const {
+            return 4;
+        }
+
+        double range_km_impl() const {
+            return fuelLitres * kmPerLitre;
+        }
+};
+
+// Tesla: print() from the Car layer, tyres and range of its own (as in the virtual version)
+class StaticTesla final : public StaticCar<StaticTesla> {
+    public:
+        StaticTesla() = default;
+
+        double batteryKwh = 75;
+
+        int tyre_count_impl() const {
+            return 4;
+        }
+
+        double range_km_impl() const {
+            return batteryKwh * 6.5;
+        }
+};
+
+using AnyVehicle = std::variant<StaticSedan, StaticTesla>;
+
+// the "virtual calls" on a mixed value: std::visit picks the alternative, the call inside is static
+inline void print(const AnyVehicle &v) {
+    std::visit([](const auto &vehicle) { vehicle.print(); }, v);
+}
+
+inline void print_tyres(const AnyVehicle &v) {
+    std::visit([](const auto &vehicle) { vehicle.print_tyres(); }, v);
+}
+
+inline int tyre_count(const AnyVehicle &v) {
+    return std::visit([](const auto &vehicle) { return vehicle.tyre_count(); }, v);
+}
+
+inline double range_km(const AnyVehicle &v) {
+    return std::visit([](const auto &vehicle) { return vehicle.range_km(); }, v);
+}
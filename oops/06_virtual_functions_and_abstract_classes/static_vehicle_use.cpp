@@ -0,0 +1,199 @@
+// build: g++ -std=c++20 -O2 static_vehicle_use.cpp
+// usage: ./a.out [vehicles]        (default 10M, ~2 GB for the three fleets)
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "../01_basics/timing.h"
+#include "static_vehicle.h"
+
+// ------------------------------------------------------------
+// The vtable version, for comparison: the hierarchy of virtual_functions_and_abstract_classes.cpp
+// with the same members as the static one
+// ------------------------------------------------------------
+
+class Vehicle {
+    public:
+        std::string color;
+        virtual ~Vehicle() {}
+        virtual void print() const = 0;
+        virtual void print_tyres() const = 0;
+        virtual int tyre_count() const = 0;
+        virtual double range_km() const = 0;
+};
+
+class Car : public Vehicle {
+    public:
+        int numGears = 5;
+        void print() const override {
+            std::cout << "Car" << std::endl;
+        }
+};
+
+class Sedan final : public Car {
+    public:
+        double fuelLitres = 40;
+        double kmPerLitre = 15;
+        void print_tyres() const override {
+            std::cout << tyre_count() << std::endl;
+        }
+        int tyre_count() const override {
+            return 4;
+        }
+        double range_km() const override {
+            return fuelLitres * kmPerLitre;
+        }
+};
+
+class Tesla final : public Car {
+    public:
+        double batteryKwh = 75;
+        void print_tyres() const override {
+            std::cout << tyre_count() << std::endl;
+        }
+        int tyre_count() const override {
+            return 4;
+        }
+        double range_km() const override {
+            return batteryKwh * 6.5;
+        }
+};
+
+// retired user-space instructions, from the PMU (perf_event_open); -1 where there is none (VMs, containers)
+template <typename F>
+long long count_instructions(F f) {
+    perf_event_attr attr{};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    const int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    if(fd < 0) {
+        f();
+        return -1;
+    }
+    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    f();
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    long long count = -1;
+    if(read(fd, &count, sizeof(count)) != sizeof(count))
+        count = -1;
+    close(fd);
+    return count;
+}
+
+void report(const char *name, double ms, long long instructions, std::size_t n, double baseline_ms) {
+    std::cout << name << ms << " ms, " << baseline_ms / ms << "x";
+    if(instructions >= 0)
+        std::cout << ", " << static_cast<double>(instructions) / static_cast<double>(n) << " instructions / vehicle";
+    else
+        std::cout << ", instructions: n/a (no PMU)";
+    std::cout << "\n";
+}
+
+int main(int argc, char **argv) {
+    StaticTesla t;
+    t.print();          // Output: Car   (from the Car layer, as in the virtual version)
+    t.print_tyres();    // Output: 4
+    // StaticVehicle<StaticTesla> v;   // error: protected constructor -- the "abstract class"
+    // StaticCar<StaticTesla> c;       // error: same, the Car layer is still abstract
+
+    std::vector<AnyVehicle> garage{StaticSedan{}, StaticTesla{}};
+    for(const AnyVehicle &v : garage)
+        std::cout << tyre_count(v) << ' ' << range_km(v) << '\n';
+    // 4 600
+    // 4 487.5
+
+    // sizes: the vptr is gone; the variant adds its index instead (one per object, not per class)
+    std::cout << "Tesla (virtual): " << sizeof(Tesla) << " bytes, StaticTesla: " << sizeof(StaticTesla)
+              << " bytes, AnyVehicle: " << sizeof(AnyVehicle) << " bytes\n";
+    // Tesla (virtual): 56 bytes, StaticTesla: 48 bytes, AnyVehicle: 64 bytes
+
+    // ------------------------------------------------------------
+    // Benchmark: total range of a mixed fleet
+    // ------------------------------------------------------------
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> kind(0, 1), litres(10, 60), battery(40, 100);
+
+    std::vector<std::unique_ptr<Vehicle>> pointers;         // the vtable way: by pointer
+    std::vector<AnyVehicle> values;                         // one contiguous mixed array
+    std::vector<StaticSedan> sedans;                        // one contiguous array per type
+    std::vector<StaticTesla> teslas;
+    pointers.reserve(n);
+    values.reserve(n);
+    for(std::size_t i = 0; i < n; i++) {
+        if(kind(rng) == 0) {
+            StaticSedan s;
+            s.fuelLitres = litres(rng);   // whole numbers: the sums are exact in any order
+            auto p = std::make_unique<Sedan>();
+            p->fuelLitres = s.fuelLitres;
+            pointers.push_back(std::move(p));
+            values.emplace_back(s);
+            sedans.push_back(s);
+        }
+        else {
+            StaticTesla s;
+            s.batteryKwh = battery(rng);
+            auto p = std::make_unique<Tesla>();
+            p->batteryKwh = s.batteryKwh;
+            pointers.push_back(std::move(p));
+            values.emplace_back(s);
+            teslas.push_back(s);
+        }
+    }
+
+    double virtual_total = 0, variant_total = 0, partitioned_total = 0;
+    long long virtual_instructions = 0, variant_instructions = 0, partitioned_instructions = 0;
+    const double virtual_ms = time_ms([&] {
+        virtual_instructions = count_instructions([&] {
+            for(const auto &p : pointers)
+                virtual_total += p->range_km();
+        });
+    });
+    const double variant_ms = time_ms([&] {
+        variant_instructions = count_instructions([&] {
+            for(const AnyVehicle &v : values)
+                variant_total += range_km(v);
+        });
+    });
+    const double partitioned_ms = time_ms([&] {
+        partitioned_instructions = count_instructions([&] {
+            for(const StaticSedan &s : sedans)
+                partitioned_total += s.range_km();
+            for(const StaticTesla &s : teslas)
+                partitioned_total += s.range_km();
+        });
+    });
+
+    std::cout << n << " vehicles, total range " << virtual_total << " km, all equal: "
+              << (virtual_total == variant_total && variant_total == partitioned_total) << "\n";
+    report("vector<unique_ptr<Vehicle>>, virtual:  ", virtual_ms, virtual_instructions, n, virtual_ms);
+    report("vector<AnyVehicle>, std::visit:        ", variant_ms, variant_instructions, n, virtual_ms);
+    report("vector<StaticSedan> + <StaticTesla>:   ", partitioned_ms, partitioned_instructions, n, virtual_ms);
+
+    // measured (10M vehicles, random 50/50 mix, -O2, a VM without a PMU):
+    //   vector<unique_ptr<Vehicle>>, virtual   ~145 ms
+    //   vector<AnyVehicle>, std::visit         ~123 ms  (~1.2x)   no indirect call, no pointer chase --
+    //                                                              but still a data-dependent branch per element
+    //   per-type vectors                       ~53 ms   (~2.7x)   no branch at all, a straight loop per type
+    // the variant wins on memory (no heap object per vehicle) more than on dispatch: on a random mix
+    // its index compare mispredicts like the indirect call does. Sorting/partitioning by type is what removes it.
+    // Instruction counts print where perf_event_open has a hardware counter (bare metal, perf_event_paranoid <= 2).
+
+    return 0;
+}
@@ -1,5 +1,9 @@
 #include <iostream>
-#include <string>
+#include <source_location>
+#include <string_view>
+
+#include "async_logger.h"
+#include "log_format.h"
 
 // Base class
 class Base {
@@ -14,12 +18,25 @@ public:
     Base(int id) : id(id) {}
 
     // Two overloaded functions
-    void log(int x) {
-        std::cout << "Base::log(int): " << x << "\n";
+    // They don't print here: the record (time, call site, value) goes to AsyncLogger,
+    // which formats and writes it on its own thread (async_logger.h).
+    // The defaulted source_location is filled in at the CALLER's line, so the log shows who called.
+    void log(int x, std::source_location where = std::source_location::current()) {
+        AsyncLogger::instance().log("Base::log(int)", x, where);
+    }
+
+    void log(double x, std::source_location where = std::source_location::current()) {
+        AsyncLogger::instance().log("Base::log(double)", x, where);
     }
 
-    void log(double x) {
-        std::cout << "Base::log(double): " << x << "\n";
+    // Any number of values, of any supported type, in one line: log("id {} scored {:.1}", id, 9.25)
+    // One template instead of an overload per type -- nothing new for Derived to re-expose.
+    // The format string is checked by the compiler against the arguments (log_format.h),
+    // and formatted into a stack buffer: no std::string, no allocation.
+    // Overload resolution still picks log(int) / log(double) for a single number (exact match beats a template).
+    template <typename... Args>
+    void log(LogFormat<Args...> format, const Args&... args) {
+        log_formatted(AsyncLogger::instance(), LogLevel::Info, format, args...);
     }
 };
 
@@ -77,8 +94,9 @@ public:
 
 
     // New overload added in Derived
-    void log(const std::string& s) {
-        std::cout << "Derived::log(string): " << s << "\n";
+    // (a string_view, not a const std::string&: a literal is viewed in place, never copied into a std::string)
+    void log(std::string_view s, std::source_location where = std::source_location::current()) {
+        AsyncLogger::instance().log("Derived::log(string)", s, where);
     }
 
 
@@ -111,8 +129,20 @@ int main() {
     d.log(3.14);     // calls Base::log(double)
 
     // Calls Derived version
+    // (the formatted template could take "hello" too: the non-template wins the tie)
     d.log("hello");
 
+    // the formatted template, found through using Base::log like the other overloads
+    d.log("id {} logged {} values, last {:.2}", d.id, 3, 3.14159);
+
+    // the log lines are written by AsyncLogger's thread: wait for them
+    // before printing through std::cout, or the order on screen is not the order of the calls
+    AsyncLogger::instance().flush();
+    // [0.000062 08_using.cpp:128] Base::log(int): 10
+    // [0.000767 08_using.cpp:129] Base::log(double): 3.14
+    // [0.000767 08_using.cpp:133] Derived::log(string): hello
+    // [0.000789 08_using.cpp:136] INFO: id 42 logged 3 values, last 3.14
+
     // Works because we exposed id publicly
     std::cout << "id = " << d.id << "\n";
 }
\ No newline at end of file
@@ -0,0 +1,415 @@
+// asynchronous logging: callers push small binary records into their own lock-free ring,
+// one background thread merges, formats and writes them in batches
+
+#pragma once
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <source_location>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "01_basics/buffered_writer.h"
+
+// The caller only timestamps the call (steady_clock) and copies a 64-byte record into its own ring:
+//   [ timestamp | label | call site | type | raw value ]
+// (a string argument's bytes follow in the next slots), then publishes it with one release store.
+// The drain thread merges all rings by timestamp, formats with std::to_chars, and writes each batch
+// through one BufferedWriter.
+//
+// Each ring is single-producer / single-consumer: the owning thread writes head_, the drain thread tail_,
+// each on its own cache line. A thread gets its ring the first time it logs; the ring is reclaimed after the
+// thread exits and its records are written. A full ring makes the caller wait (counted in producer_stalls()).
+// While records keep coming, the drain thread naps 200 us between batches; after a pass that found nothing
+// it sleeps until the next push() (which then pays a lock and a notify, once), flush() or shutdown.
+//
+// Order: per thread, the order of the calls; across threads, timestamp order within a batch.
+// Call flush() before writing to the same fd any other way (e.g. std::cout).
+
+namespace async_log_detail {
+
+constexpr std::size_t kSlotSize = 64;
+
+enum class ArgType : std::uint8_t { Int, UInt, Double, String };
+
+struct RecordHeader {
+    std::uint64_t timestamp_ns;
+    const char *label;              // a string literal
+    std::source_location site;
+    std::uint32_t length;           // String: byte count (the bytes follow the header)
+    ArgType type;
+    union {
+        std::int64_t i;
+        std::uint64_t u;
+        double d;
+    } value;
+};
+static_assert(sizeof(RecordHeader) <= kSlotSize, "a record header fits in one slot");
+
+constexpr std::size_t slots_for(std::size_t string_length) {
+    return (sizeof(RecordHeader) + string_length + kSlotSize - 1) / kSlotSize;
+}
+
+class LogRing {
+
+public:
+    static constexpr std::size_t kSlots = 1 << 14;   // 1 MB per logging thread
+
+    LogRing() : bytes_(std::make_unique<unsigned char[]>(kSlots * kSlotSize)) {}
+
+    // producer (the owning thread); returns false if it had to wait for space
+    bool push(const RecordHeader &header, std::string_view text) {
+        const std::uint64_t head = head_.load(std::memory_order_relaxed);
+        const std::size_t slots = slots_for(text.size());
+        bool waited = false;
+        while(head + slots - cached_tail_ > kSlots) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if(head + slots - cached_tail_ > kSlots) {
+                waited = true;
+                std::this_thread::yield();
+            }
+        }
+        const std::size_t at = (head % kSlots) * kSlotSize;
+        std::memcpy(bytes_.get() + at, &header, sizeof(header));   // a slot never wraps
+        copy_in(at + sizeof(header), text);
+        head_.store(head + slots, std::memory_order_release);
+        return !waited;
+    }
+
+    // consumer (the drain thread): f(header, text) for every published record, oldest first
+    template <typename F>
+    std::size_t drain(F &&f, std::vector<char> &scratch) {
+        const std::uint64_t head = head_.load(std::memory_order_acquire);
+        std::uint64_t tail = tail_.load(std::memory_order_relaxed);
+        std::size_t records = 0;
+        while(tail < head) {
+            RecordHeader header;
+            const std::size_t at = (tail % kSlots) * kSlotSize;
+            std::memcpy(&header, bytes_.get() + at, sizeof(header));
+            scratch.resize(header.length);
+            copy_out(at + sizeof(header), scratch.data(), header.length);
+            f(header, std::string_view(scratch.data(), header.length));
+            tail += slots_for(header.length);
+            records++;
+        }
+        tail_.store(tail, std::memory_order_release);
+        return records;
+    }
+
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    std::atomic<bool> abandoned{false};   // the owning thread has exited
+
+private:
+    // string bytes may wrap around the end of the ring
+    void copy_in(std::size_t at, std::string_view text) {
+        if(text.empty())
+            return;
+        const std::size_t total = kSlots * kSlotSize;
+        at %= total;
+        const std::size_t first = std::min(text.size(), total - at);
+        std::memcpy(bytes_.get() + at, text.data(), first);
+        std::memcpy(bytes_.get(), text.data() + first, text.size() - first);
+    }
+
+    void copy_out(std::size_t at, char *out, std::size_t length) const {
+        if(length == 0)
+            return;
+        const std::size_t total = kSlots * kSlotSize;
+        at %= total;
+        const std::size_t first = std::min(length, total - at);
+        std::memcpy(out, bytes_.get() + at, first);
+        std::memcpy(out + first, bytes_.get(), length - first);
+    }
+
+    std::unique_ptr<unsigned char[]> bytes_;
+    alignas(kSlotSize) std::atomic<std::uint64_t> head_{0};   // written by the producer only
+    std::uint64_t cached_tail_ = 0;                          // producer's last look at tail_
+    alignas(kSlotSize) std::atomic<std::uint64_t> tail_{0};   // written by the drain thread only
+};
+
+// a record taken out of a ring, waiting in the drain thread's batch
+struct PendingRecord {
+    RecordHeader header;
+    std::size_t text_offset;   // into the batch's text buffer
+};
+
+}   // namespace async_log_detail
+
+
+class AsyncLogger {
+
+public:
+    // the process-wide logger, writing to stdout; started on first use, stopped (and fully written) at exit
+    static AsyncLogger& instance() {
+        static AsyncLogger logger(STDOUT_FILENO);
+        return logger;
+    }
+
+    // show_source: prefix every line with "[seconds file:line] "
+    explicit AsyncLogger(int fd, bool show_source = true)
+        : writer_(fd), show_source_(show_source), start_(now_ns()), drainer_([this] { drain_loop(); }) {}
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    // every thread that logged must have stopped logging by now
+    ~AsyncLogger() {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_one();
+        drainer_.join();
+    }
+
+    template <std::integral T>
+    void log(const char *label, T value, std::source_location site = std::source_location::current()) {
+        constexpr async_log_detail::ArgType type =
+            std::is_signed_v<T> ? async_log_detail::ArgType::Int : async_log_detail::ArgType::UInt;
+        async_log_detail::RecordHeader header{now_ns(), label, site, 0, type, {}};
+        if constexpr(std::is_signed_v<T>)
+            header.value.i = value;
+        else
+            header.value.u = value;
+        push(header, {});
+    }
+
+    void log(const char *label, double value, std::source_location site = std::source_location::current()) {
+        async_log_detail::RecordHeader header{now_ns(), label, site, 0, async_log_detail::ArgType::Double, {}};
+        header.value.d = value;
+        push(header, {});
+    }
+
+    // longer than a ring holds: truncated (a ring is 1 MB)
+    void log(const char *label, std::string_view text, std::source_location site = std::source_location::current()) {
+        constexpr std::size_t kMaxText = (async_log_detail::LogRing::kSlots / 2) * async_log_detail::kSlotSize;
+        text = text.substr(0, kMaxText);
+        async_log_detail::RecordHeader header{now_ns(), label, site, static_cast<std::uint32_t>(text.size()),
+                                              async_log_detail::ArgType::String, {}};
+        push(header, text);
+    }
+
+    // returns once everything logged before the call (by any thread) has been written
+    void flush() {
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        const std::uint64_t ticket = ++flush_requested_;
+        wake_.notify_one();
+        flushed_.wait(lock, [&] { return flush_completed_ >= ticket; });
+    }
+
+    std::uint64_t producer_stalls() const {
+        return stalls_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static std::uint64_t now_ns() {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // this thread's ring for this logger, created on its first record.
+    // Shared: the thread's handle marks it abandoned at thread exit, even if the logger is gone by then.
+    struct ThreadRings {
+        std::vector<std::pair<std::uint64_t, std::shared_ptr<async_log_detail::LogRing>>> rings;   // (logger id, ring)
+        ~ThreadRings() {
+            for(const auto &entry : rings)
+                entry.second->abandoned.store(true, std::memory_order_release);
+        }
+    };
+
+    async_log_detail::LogRing& thread_ring() {
+        thread_local ThreadRings mine;
+        for(const auto &entry : mine.rings) {   // one entry per logger this thread used: usually one
+            if(entry.first == id_)
+                return *entry.second;
+        }
+        auto ring = std::make_shared<async_log_detail::LogRing>();
+        {
+            std::lock_guard<std::mutex> lock(rings_mutex_);
+            rings_.push_back(ring);
+        }
+        mine.rings.emplace_back(id_, ring);
+        return *ring;
+    }
+
+    void push(const async_log_detail::RecordHeader &header, std::string_view text) {
+        if(!thread_ring().push(header, text))
+            stalls_.fetch_add(1, std::memory_order_relaxed);
+        // the drain thread may have found every ring empty and gone to sleep: if so, wake it.
+        // The fence orders the publish above before the look at idle_; drain_loop() fences idle_ = true
+        // before its look at the rings, so at least one of the two sees the other.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(idle_.load(std::memory_order_relaxed)) [[unlikely]] {
+            {
+                std::lock_guard<std::mutex> lock(wake_mutex_);
+                idle_.store(false, std::memory_order_relaxed);
+            }
+            wake_.notify_one();
+        }
+    }
+
+    bool all_rings_empty() {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        return std::all_of(rings_.begin(), rings_.end(),
+                           [](const std::shared_ptr<async_log_detail::LogRing> &ring) { return ring->empty(); });
+    }
+
+    void drain_loop() {
+        std::vector<async_log_detail::LogRing*> rings;
+        std::vector<async_log_detail::PendingRecord> batch;
+        std::vector<char> text;
+        std::vector<char> scratch;
+        bool drained = false;   // did the last pass find any records?
+        while(true) {
+            std::uint64_t ticket;
+            bool stopping;
+            {
+                std::unique_lock<std::mutex> lock(wake_mutex_);
+                const auto work = [&] { return stopping_ || flush_requested_ > flush_completed_; };
+                if(drained) {
+                    // busy: a short nap lets records pile up into the next batch, and producers don't notify
+                    wake_.wait_for(lock, std::chrono::microseconds(200), work);
+                }
+                else if(!work()) {
+                    // a pass found nothing: sleep, with no timeout, until a producer publishes (push() notifies
+                    // while idle_ is set), a flush() is requested, or the logger stops
+                    idle_.store(true, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);   // pairs with the fence in push()
+                    if(all_rings_empty()) {
+                        wake_.wait(lock, [&] { return !idle_.load(std::memory_order_relaxed) || work(); });
+                    }
+                    idle_.store(false, std::memory_order_relaxed);
+                }
+                ticket = flush_requested_;
+                stopping = stopping_;
+            }
+
+            // every record published before this point is taken in this pass
+            {
+                std::lock_guard<std::mutex> lock(rings_mutex_);
+                // finished threads whose records are all out: drop their rings
+                std::erase_if(rings_, [](const std::shared_ptr<async_log_detail::LogRing> &ring) {
+                    return ring->abandoned.load(std::memory_order_acquire) && ring->empty();
+                });
+                rings.clear();
+                for(const auto &ring : rings_)
+                    rings.push_back(ring.get());
+            }
+            batch.clear();
+            text.clear();
+            for(async_log_detail::LogRing *ring : rings) {
+                ring->drain([&](const async_log_detail::RecordHeader &header, std::string_view s) {
+                    batch.push_back({header, text.size()});
+                    text.insert(text.end(), s.begin(), s.end());
+                }, scratch);
+            }
+            drained = !batch.empty();
+            // each ring is already in order: a stable sort keeps it, and interleaves the threads by time
+            std::stable_sort(batch.begin(), batch.end(), [](const auto &a, const auto &b) {
+                return a.header.timestamp_ns < b.header.timestamp_ns;
+            });
+            // the writer flushes on its own whenever its 64 KB fill up, so formatting throws write errors too
+            try {
+                for(const async_log_detail::PendingRecord &record : batch)
+                    format(record, text);
+                writer_.flush();
+            }
+            catch(const std::system_error&) {
+                // nowhere to report it: the rest of the batch is dropped, logging goes on
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(wake_mutex_);
+                flush_completed_ = ticket;
+            }
+            flushed_.notify_all();
+            if(stopping)
+                return;   // the last pass took everything
+        }
+    }
+
+    void format(const async_log_detail::PendingRecord &record, const std::vector<char> &text) {
+        const async_log_detail::RecordHeader &h = record.header;
+        if(show_source_) {
+            // [12.345678 08_using.cpp:117]
+            const std::uint64_t since_start = h.timestamp_ns - start_;
+            writer_.put('[');
+            writer_.write_int(since_start / 1'000'000'000);
+            writer_.put('.');
+            char micros[7];
+            std::uint64_t us = since_start / 1000 % 1'000'000;
+            for(int i = 5; i >= 0; i--, us /= 10)
+                micros[i] = static_cast<char>('0' + us % 10);
+            writer_.write(std::string_view(micros, 6));
+            writer_.put(' ');
+            std::string_view file = h.site.file_name();
+            if(const std::size_t slash = file.rfind('/'); slash != std::string_view::npos)
+                file.remove_prefix(slash + 1);
+            writer_.write(file);
+            writer_.put(':');
+            writer_.write_int(h.site.line());
+            writer_.write("] ");
+        }
+        writer_.write(h.label);
+        writer_.write(": ");
+        switch(h.type) {
+            case async_log_detail::ArgType::Int:
+                writer_.write_int(h.value.i);
+                break;
+            case async_log_detail::ArgType::UInt:
+                writer_.write_int(h.value.u);
+                break;
+            case async_log_detail::ArgType::Double: {
+                // like std::cout's default (%g, 6 significant digits)
+                char digits[32];
+                const std::to_chars_result result =
+                    std::to_chars(digits, digits + sizeof(digits), h.value.d, std::chars_format::general, 6);
+                writer_.write(std::string_view(digits, static_cast<std::size_t>(result.ptr - digits)));
+                break;
+            }
+            case async_log_detail::ArgType::String:
+                writer_.write(std::string_view(text.data() + record.text_offset, h.length));
+                break;
+        }
+        writer_.put('\n');
+    }
+
+    static inline std::atomic<std::uint64_t> next_id_{1};
+    const std::uint64_t id_ = next_id_.fetch_add(1, std::memory_order_relaxed);   // addresses get reused, ids don't
+
+    BufferedWriter writer_;   // drain thread only
+    const bool show_source_;
+    const std::uint64_t start_;
+
+    std::mutex rings_mutex_;   // registration (once per thread) and the drain thread's snapshot
+    std::vector<std::shared_ptr<async_log_detail::LogRing>> rings_;
+    std::atomic<std::uint64_t> stalls_{0};
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;      // drain thread: work or stop
+    std::atomic<bool> idle_{false};     // the drain thread found every ring empty and is (about to be) asleep
+    std::condition_variable flushed_;   // flush() callers
+    std::uint64_t flush_requested_ = 0;
+    std::uint64_t flush_completed_ = 0;
+    bool stopping_ = false;
+
+    std::thread drainer_;   // last: starts after everything above is initialized
+};
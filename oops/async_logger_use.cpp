@@ -0,0 +1,141 @@
+// build: g++ -std=c++20 -O2 -pthread async_logger_use.cpp
+// usage: ./a.out [records per thread]        (default 1M)
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "01_basics/timing.h"
+#include "async_logger.h"
+
+// f(thread index) on `threads` threads at once; returns each thread's own time
+template <typename F>
+std::vector<double> run_threads(unsigned threads, F f) {
+    std::vector<double> per_thread_ms(threads);
+    std::vector<std::thread> workers;
+    for(unsigned t = 0; t < threads; t++)
+        workers.emplace_back([&, t] { per_thread_ms[t] = time_ms([&] { f(t); }); });
+    for(std::thread &worker : workers)
+        worker.join();
+    return per_thread_ms;
+}
+
+double average(const std::vector<double> &values) {
+    double total = 0;
+    for(double v : values)
+        total += v;
+    return total / static_cast<double>(values.size());
+}
+
+int main(int argc, char **argv) {
+    {
+        // to stdout, with the source prefix
+        AsyncLogger logger(STDOUT_FILENO);
+        logger.log("answer", 42);
+        logger.log("pi", 3.14159265);
+        logger.log("name", std::string_view("Alice"));
+        logger.flush();
+        // [0.000012 async_logger_use.cpp:48] answer: 42
+        // [0.000015 async_logger_use.cpp:49] pi: 3.14159
+        // [0.000016 async_logger_use.cpp:50] name: Alice
+    }
+
+    // ------------------------------------------------------------
+    // Benchmark: caller latency and throughput, output to /dev/null
+    // ------------------------------------------------------------
+    const std::size_t records = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    const int dev_null = ::open("/dev/null", O_WRONLY);
+
+    // caller latency: a burst that fits in the ring, so the caller never waits for the drain thread
+    {
+        AsyncLogger logger(dev_null);
+        constexpr int kBurst = 10'000;
+        logger.log("warm-up", 0);   // first record of a thread allocates its ring
+        const double ms = time_ms([&] {
+            for(int i = 0; i < kBurst; i++)
+                logger.log("Base::log(int)", i);
+        });
+        logger.flush();
+        std::cout << "caller latency, AsyncLogger:       " << ms * 1e6 / kBurst << " ns / call\n";
+    }
+    {
+        // the same calls, formatted and written by the caller (what Base::log did)
+        std::cout.flush();   // what is buffered so far belongs on the terminal
+        const int saved_stdout = ::dup(STDOUT_FILENO);
+        ::dup2(dev_null, STDOUT_FILENO);
+        constexpr int kBurst = 10'000;
+        const double ms = time_ms([&] {
+            for(int i = 0; i < kBurst; i++)
+                std::cout << "Base::log(int): " << i << "\n";
+            std::cout.flush();
+        });
+        ::dup2(saved_stdout, STDOUT_FILENO);
+        ::close(saved_stdout);
+        std::cout << "caller latency, std::cout:         " << ms * 1e6 / kBurst << " ns / call\n";
+    }
+
+    // sustained throughput from N threads: end to end, until the last record is written
+    for(unsigned threads : {1u, 2u, 4u, 8u}) {
+        AsyncLogger logger(dev_null);
+        std::vector<double> per_thread;
+        const double total_ms = time_ms([&] {
+            per_thread = run_threads(threads, [&](unsigned t) {
+                for(std::size_t i = 0; i < records; i++)
+                    logger.log("Base::log(int)", static_cast<long long>(t * records + i));
+            });
+            logger.flush();
+        });
+        const double all = static_cast<double>(records) * threads;
+        std::cout << threads << " thread(s), AsyncLogger: " << all / total_ms / 1e3 << " M records/s, "
+                  << average(per_thread) * 1e6 / static_cast<double>(records) << " ns / call (incl. waits), "
+                  << logger.producer_stalls() << " stalls\n";
+    }
+
+    // the same with std::cout from every thread (one stream, one lock)
+    for(unsigned threads : {1u, 2u, 4u, 8u}) {
+        std::cout.flush();   // what is buffered so far belongs on the terminal
+        const int saved_stdout = ::dup(STDOUT_FILENO);
+        ::dup2(dev_null, STDOUT_FILENO);
+        std::mutex cout_mutex;   // whole lines: without it, the pieces of different threads' lines interleave
+        const double total_ms = time_ms([&] {
+            run_threads(threads, [&](unsigned t) {
+                for(std::size_t i = 0; i < records; i++) {
+                    std::lock_guard<std::mutex> lock(cout_mutex);
+                    std::cout << "Base::log(int): " << t * records + i << "\n";
+                }
+            });
+            std::cout.flush();
+        });
+        ::dup2(saved_stdout, STDOUT_FILENO);
+        ::close(saved_stdout);
+        const double all = static_cast<double>(records) * threads;
+        std::cout << threads << " thread(s), std::cout:   " << all / total_ms / 1e3 << " M records/s\n";
+    }
+
+    ::close(dev_null);
+    return 0;
+}
+
+// Measured (g++ 12 -O2, 1M records per thread, 1-core VM, output to /dev/null):
+//   caller latency, burst that fits in the ring:   AsyncLogger ~47 ns / call    std::cout ~90 ns / call
+//     (the 47 ns: a clock read, a 64-byte copy into the ring, one release store -- no formatting, no syscall --
+//     and a fence before the look at the drain thread's idle flag: ~8 ns of it. Without the flag, the drain
+//     thread polled every 200 us while idle, ~3700 wake-ups a second; now an idle logger has none.)
+//   sustained, end to end including flush():
+//     threads   AsyncLogger        ns / call incl. waits   stalls     std::cout + mutex
+//       1       ~6.7-7.3 M records/s ~135-150                60        ~6.5-7.4 M records/s
+//       2       ~5.0-6.1             ~330-400               122        ~6.4-8.8
+//       4       ~5.0-5.2             ~750-790               244        ~6.4-8.4
+//       8       ~4.7-4.9             ~1600-1690             488        ~7.1
+//
+// On one core, sustained throughput can't improve: every record is still formatted and written once, only by
+// another thread, and the producers and the drain thread take turns on the same CPU. Once a ring fills, the
+// producer yields (the policy is to block, never drop), so "ns / call incl. waits" is the drain rate shared
+// between N producers. What the logger buys is the first line: a call that doesn't format, lock or write,
+// as long as the drain thread keeps up on average -- which needs a core of its own.
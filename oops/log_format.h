@@ -0,0 +1,308 @@
+// formatted logging: "{}" format strings checked by the compiler, formatted into a stack buffer,
+// disabled levels compiled out -- a front end for AsyncLogger
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <source_location>
+#include <string_view>
+#include <type_traits>
+
+#include "async_logger.h"
+
+// log_formatted(logger, LogLevel::Info, "id {} scored {:.2} in {}", id, score, subject);
+//   the format string is parsed in a consteval constructor: a wrong placeholder count, an unmatched brace
+//   or a spec that doesn't fit the argument ({:x} on a double) fails the build
+//   the line is formatted into a char[kLogLineCapacity] on the caller's stack (std::to_chars, memcpy) and
+//   handed to the logger as one string record: no heap allocation. A line that doesn't fit is cut, ending in "..."
+// (std::format isn't in GCC 12's library, and would return a std::string per message.)
+//
+// Placeholders:  {}     any supported argument (integers, bool, char, floating point, strings, pointers)
+//                {:x}   integer in hex
+//                {:.N}  floating point with N decimals (N <= 17)
+//                {{ }}  literal braces
+//
+// LOG_DEBUG(...), LOG_INFO(...), ...: a level below LOG_MIN_LEVEL (-DLOG_MIN_LEVEL=Debug) is an
+// `if constexpr (false)`: the format is still checked, but the arguments are not evaluated.
+
+enum class LogLevel : int { Trace, Debug, Info, Warn, Error };
+
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL Info
+#endif
+
+inline constexpr LogLevel kLogMinLevel = LogLevel::LOG_MIN_LEVEL;
+
+constexpr const char* log_level_name(LogLevel level) {
+    switch(level) {
+        case LogLevel::Trace: return "TRACE";
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info:  return "INFO";
+        case LogLevel::Warn:  return "WARN";
+        case LogLevel::Error: return "ERROR";
+    }
+    return "?";
+}
+
+inline constexpr std::size_t kLogLineCapacity = 512;   // longer lines are cut, and end in "..."
+
+namespace log_format_detail {
+
+enum class ArgKind : std::uint8_t { Signed, Unsigned, Bool, Char, Floating, String, Pointer };
+
+template <typename T>
+consteval ArgKind kind_of() {
+    using U = std::remove_cvref_t<T>;
+    if constexpr(std::is_same_v<U, bool>)
+        return ArgKind::Bool;
+    else if constexpr(std::is_same_v<U, char>)
+        return ArgKind::Char;
+    else if constexpr(std::is_integral_v<U> && std::is_signed_v<U>)
+        return ArgKind::Signed;
+    else if constexpr(std::is_integral_v<U>)
+        return ArgKind::Unsigned;
+    else if constexpr(std::is_floating_point_v<U>)
+        return ArgKind::Floating;
+    else if constexpr(std::is_convertible_v<const U&, std::string_view>)
+        return ArgKind::String;
+    else if constexpr(std::is_pointer_v<U> || std::is_null_pointer_v<U>)
+        return ArgKind::Pointer;
+    else
+        static_assert(sizeof(U) == 0, "log format: no formatting for this argument type");
+}
+
+enum class Spec : std::uint8_t { Default, Hex, Fixed };
+
+// one {} in the format string: where it is, and how to format its argument
+struct Placeholder {
+    std::uint16_t begin = 0;    // offset of '{'
+    std::uint16_t end = 0;      // one past '}'
+    Spec spec = Spec::Default;
+    std::uint8_t precision = 0;
+    bool escaped_before = false;   // the literal piece before it has "{{" or "}}"
+};
+
+// not constexpr: reaching one while the consteval constructor runs is the compile error, and its name the message
+void unmatched_open_brace_in_log_format();
+void unmatched_close_brace_in_log_format();
+void unknown_placeholder_spec_in_log_format();
+void hex_spec_needs_an_integer_argument();
+void precision_spec_needs_a_floating_point_argument();
+void more_placeholders_than_arguments_in_log_format();
+void more_arguments_than_placeholders_in_log_format();
+void log_format_string_too_long();
+
+// a literal piece between placeholders: copied, with "{{" and "}}" turned into one brace
+// (escaped: the piece has such pairs -- known from the parse, so the usual piece is one memcpy).
+// Each writer below sets cut when it couldn't write all of its text.
+inline char* copy_literal(char *out, char *limit, std::string_view text, bool escaped, bool &cut) {
+    if(!escaped) {
+        const std::size_t n = std::min(text.size(), static_cast<std::size_t>(limit - out));
+        std::memcpy(out, text.data(), n);
+        cut = cut || n < text.size();
+        return out + n;
+    }
+    std::size_t i = 0;
+    for(; i < text.size() && out < limit; i++) {
+        *out++ = text[i];
+        if(text[i] == '{' || text[i] == '}')
+            i++;   // in a checked format string, a brace in a literal piece is always doubled
+    }
+    cut = cut || i < text.size();
+    return out;
+}
+
+// a number that doesn't fit is left out whole (to_chars writes nothing then): out comes back as it was
+template <typename T>
+char* format_arg(char *out, char *limit, const Placeholder &p, const T &value, bool &cut) {
+    constexpr ArgKind kind = kind_of<T>();
+    if constexpr(kind == ArgKind::Bool) {
+        return copy_literal(out, limit, value ? "true" : "false", false, cut);
+    }
+    else if constexpr(kind == ArgKind::Char) {
+        if(out == limit) {
+            cut = true;
+            return out;
+        }
+        *out++ = value;
+        return out;
+    }
+    else if constexpr(kind == ArgKind::Signed || kind == ArgKind::Unsigned) {
+        const std::to_chars_result r = std::to_chars(out, limit, value, p.spec == Spec::Hex ? 16 : 10);
+        cut = cut || r.ec != std::errc();
+        return r.ec == std::errc() ? r.ptr : out;
+    }
+    else if constexpr(kind == ArgKind::Floating) {
+        // default: like std::cout (6 significant digits); {:.N}: N decimals
+        const std::to_chars_result r = p.spec == Spec::Fixed
+            ? std::to_chars(out, limit, value, std::chars_format::fixed, p.precision)
+            : std::to_chars(out, limit, value, std::chars_format::general, 6);
+        cut = cut || r.ec != std::errc();
+        return r.ec == std::errc() ? r.ptr : out;
+    }
+    else if constexpr(kind == ArgKind::String) {
+        return copy_literal(out, limit, std::string_view(value), false, cut);
+    }
+    else {
+        const std::to_chars_result r = limit - out < 2
+            ? std::to_chars_result{out, std::errc::value_too_large}
+            : std::to_chars(out + 2, limit, reinterpret_cast<std::uintptr_t>(static_cast<const void*>(value)), 16);
+        if(r.ec != std::errc()) {
+            cut = true;
+            return out;
+        }
+        out[0] = '0';
+        out[1] = 'x';
+        return r.ptr;
+    }
+}
+
+}   // namespace log_format_detail
+
+
+// the format string of a call with arguments Args..., checked while it is constructed (consteval).
+// Also records the call site: the default argument is evaluated where the format string is written.
+template <typename... Args>
+class BasicLogFormat {
+
+public:
+    template <std::size_t N>
+    consteval BasicLogFormat(const char (&text)[N], std::source_location site = std::source_location::current())
+        : text_(text, N - 1), site_(site) {
+        using namespace log_format_detail;
+        constexpr std::array<ArgKind, sizeof...(Args)> kinds{kind_of<Args>()...};
+        if(text_.size() > UINT16_MAX)
+            log_format_string_too_long();
+
+        std::size_t arg = 0;
+        bool escaped = false;   // in the current literal piece
+        for(std::size_t i = 0; i < text_.size(); i++) {
+            if(text_[i] == '}') {
+                if(i + 1 == text_.size() || text_[i + 1] != '}')
+                    unmatched_close_brace_in_log_format();
+                escaped = true;
+                i++;
+                continue;
+            }
+            if(text_[i] != '{')
+                continue;
+            if(i + 1 < text_.size() && text_[i + 1] == '{') {
+                escaped = true;
+                i++;
+                continue;
+            }
+            const std::size_t close = text_.find('}', i);
+            if(close == std::string_view::npos)
+                unmatched_open_brace_in_log_format();
+            if(arg == sizeof...(Args))
+                more_placeholders_than_arguments_in_log_format();
+
+            Placeholder p;
+            p.begin = static_cast<std::uint16_t>(i);
+            p.end = static_cast<std::uint16_t>(close + 1);
+            p.escaped_before = escaped;
+            escaped = false;
+            const std::string_view spec = text_.substr(i + 1, close - i - 1);
+            if(spec == ":x") {
+                if(kinds[arg] != ArgKind::Signed && kinds[arg] != ArgKind::Unsigned)
+                    hex_spec_needs_an_integer_argument();
+                p.spec = Spec::Hex;
+            }
+            else if(spec.size() >= 3 && spec.size() <= 4 && spec.substr(0, 2) == ":.") {
+                unsigned precision = 0;
+                for(char c : spec.substr(2)) {
+                    if(c < '0' || c > '9')
+                        unknown_placeholder_spec_in_log_format();
+                    precision = precision * 10 + static_cast<unsigned>(c - '0');
+                }
+                if(precision > 17)
+                    unknown_placeholder_spec_in_log_format();
+                if(kinds[arg] != ArgKind::Floating)
+                    precision_spec_needs_a_floating_point_argument();
+                p.spec = Spec::Fixed;
+                p.precision = static_cast<std::uint8_t>(precision);
+            }
+            else if(!spec.empty()) {
+                unknown_placeholder_spec_in_log_format();
+            }
+            placeholders_[arg++] = p;
+            i = close;
+        }
+        if(arg != sizeof...(Args))
+            more_arguments_than_placeholders_in_log_format();
+        tail_escaped_ = escaped;
+    }
+
+    // the formatted text, into [out, out + capacity); returns its length.
+    // A line that doesn't fit stops where the first piece didn't and ends in "..." (within capacity, which must
+    // be at least 3); a line that fits exactly is left alone.
+    std::size_t format_to(char *out, std::size_t capacity, const Args&... args) const {
+        using namespace log_format_detail;
+        char *at = out;
+        char *const limit = out + capacity;
+        bool cut = false;
+        std::size_t literal_begin = 0;
+        std::size_t i = 0;
+        [[maybe_unused]] const auto piece = [&](const auto &arg) {   // unused when there are no arguments
+            const Placeholder &p = placeholders_[i++];
+            if(!cut)
+                at = copy_literal(at, limit, text_.substr(literal_begin, p.begin - literal_begin), p.escaped_before, cut);
+            if(!cut)
+                at = format_arg(at, limit, p, arg, cut);
+            literal_begin = p.end;
+        };
+        (piece(args), ...);
+        if(!cut)
+            at = copy_literal(at, limit, text_.substr(literal_begin), tail_escaped_, cut);
+        if(cut) {
+            at = std::min(at, limit - 3);
+            std::memcpy(at, "...", 3);
+            at += 3;
+        }
+        return static_cast<std::size_t>(at - out);
+    }
+
+    std::string_view text() const {
+        return text_;
+    }
+
+    const std::source_location& site() const {
+        return site_;
+    }
+
+private:
+    std::string_view text_;   // a string literal: static storage
+    std::source_location site_;
+    std::array<log_format_detail::Placeholder, sizeof...(Args)> placeholders_{};
+    bool tail_escaped_ = false;   // the literal piece after the last placeholder has "{{" or "}}"
+};
+
+// as std::format_string: type_identity keeps the format string out of template argument deduction,
+// so Args come from the arguments only
+template <typename... Args>
+using LogFormat = BasicLogFormat<std::type_identity_t<Args>...>;
+
+template <typename... Args>
+void log_formatted(AsyncLogger &logger, LogLevel level, LogFormat<Args...> format, const Args&... args) {
+    char line[kLogLineCapacity];
+    const std::size_t length = format.format_to(line, sizeof(line), args...);
+    logger.log(log_level_name(level), std::string_view(line, length), format.site());
+}
+
+#define LOG_AT(logger, level, ...)                                      \
+    do {                                                                \
+        if constexpr((level) >= kLogMinLevel)                           \
+            log_formatted((logger), (level), __VA_ARGS__);              \
+    } while(0)
+
+#define LOG_TRACE(...) LOG_AT(AsyncLogger::instance(), LogLevel::Trace, __VA_ARGS__)
+#define LOG_DEBUG(...) LOG_AT(AsyncLogger::instance(), LogLevel::Debug, __VA_ARGS__)
+#define LOG_INFO(...)  LOG_AT(AsyncLogger::instance(), LogLevel::Info, __VA_ARGS__)
+#define LOG_WARN(...)  LOG_AT(AsyncLogger::instance(), LogLevel::Warn, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT(AsyncLogger::instance(), LogLevel::Error, __VA_ARGS__)
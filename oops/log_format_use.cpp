@@ -0,0 +1,198 @@
+// build: g++ -std=c++20 -O2 -pthread log_format_use.cpp
+//        g++ -std=c++20 -O2 -pthread -DLOG_MIN_LEVEL=Debug log_format_use.cpp    (LOG_DEBUG lines compiled in)
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <string_view>
+
+#include "01_basics/timing.h"
+#include "log_format.h"
+
+// every heap allocation in the program goes through here: counted per thread
+// (the caller's count: the drain thread's own buffers are not the caller's cost)
+thread_local std::size_t t_allocations = 0;
+
+void* operator new(std::size_t size) {
+    t_allocations++;
+    if(void *p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+template <typename F>
+std::size_t allocations_in(F f) {
+    const std::size_t before = t_allocations;
+    f();
+    return t_allocations - before;
+}
+
+int g_failures = 0;
+
+void expect(std::string_view what, std::string_view got, std::string_view expected) {
+    if(got != expected) {
+        std::cout << "FAILED " << what << ": \"" << got << "\", expected \"" << expected << "\"\n";
+        g_failures++;
+    }
+}
+
+template <typename... Args>
+std::string_view format_into(char (&buffer)[kLogLineCapacity], LogFormat<Args...> format, const Args&... args) {
+    return std::string_view(buffer, format.format_to(buffer, sizeof(buffer), args...));
+}
+
+// the overloads of 08_using.cpp before the formatted front end: one value, one record per call
+void old_log(AsyncLogger &logger, int x) {
+    logger.log("Base::log(int)", x);
+}
+
+void old_log(AsyncLogger &logger, const std::string &s) {
+    logger.log("Derived::log(string)", s);
+}
+
+int main() {
+    // ------------------------------------------------------------
+    // formatting
+    // ------------------------------------------------------------
+    char line[kLogLineCapacity];
+    const std::string name = "Alice";
+    expect("ints", format_into(line, "{} {} {}", 42, -7, 18446744073709551615ull), "42 -7 18446744073709551615");
+    expect("hex", format_into(line, "{:x}", 255), "ff");
+    expect("double", format_into(line, "{} {:.2} {:.0}", 3.14159265, 2.0 / 3, 2.5), "3.14159 0.67 2");
+    expect("strings", format_into(line, "{} / {} / {}", name, "literal", std::string_view("view")),
+           "Alice / literal / view");
+    expect("bool, char", format_into(line, "{} {}{}", true, 'o', 'k'), "true ok");
+    expect("braces", format_into(line, "{{{}}}", 1), "{1}");
+    expect("no args", format_into(line, "plain"), "plain");
+    const std::string long_text(kLogLineCapacity + 100, 'x');
+    const std::string_view cut = format_into(line, "{}", long_text);
+    expect("cut", cut.substr(cut.size() - 4), "x...");
+    const std::string almost_full(kLogLineCapacity - 10, 'x');
+    const std::string_view dropped = format_into(line, "{} {:.2}", almost_full, 1e300);   // 303 chars don't fit
+    expect("number left out", dropped.substr(dropped.size() - 5), "x ...");
+    const std::string_view exact = format_into(line, "{}1234567890", almost_full);
+    expect("exact fit", exact.substr(exact.size() - 4), "7890");
+    std::cout << "formatting: " << (g_failures == 0 ? "ok" : "FAILED") << '\n';   // formatting: ok
+
+    // these don't compile (uncomment to see the error -- the name of the check that failed):
+    // format_into(line, "{} {}", 1);         // more_placeholders_than_arguments_in_log_format
+    // format_into(line, "{}", 1, 2);         // more_arguments_than_placeholders_in_log_format
+    // format_into(line, "{:x}", 1.5);        // hex_spec_needs_an_integer_argument
+    // format_into(line, "{:.2}", 7);         // precision_spec_needs_a_floating_point_argument
+    // format_into(line, "{", 1);             // unmatched_open_brace_in_log_format
+    // format_into(line, "{:>8}", 1);         // unknown_placeholder_spec_in_log_format
+    // struct Point { int x, y; };
+    // format_into(line, "{}", Point{});      // static_assert: no formatting for this argument type
+
+    // compiled out below LOG_MIN_LEVEL (Info by default): the argument is never evaluated
+    int evaluated = 0;
+    LOG_DEBUG("debug {}", ++evaluated);
+    std::cout << "LOG_DEBUG evaluated its argument: " << (evaluated ? "yes" : "no") << '\n';   // no (yes with -DLOG_MIN_LEVEL=Debug)
+
+    std::cout.flush();   // AsyncLogger writes to the same fd
+    LOG_INFO("{} scored {:.1} in {}", name, 91.25, "maths");
+    AsyncLogger::instance().flush();
+    // [0.000059 log_format_use.cpp:110] INFO: Alice scored 91.2 in maths
+
+
+    // ------------------------------------------------------------
+    // allocations per call (after the thread's first record, which allocates its ring)
+    // ------------------------------------------------------------
+    const int dev_null = ::open("/dev/null", O_WRONLY);
+    constexpr int kCalls = 10'000;
+    {
+        AsyncLogger logger(dev_null);
+        logger.log("warm-up", 0);
+        const std::string student = "Bartholomew Montgomery-Smythe";   // longer than std::string's inline buffer
+
+        const std::size_t formatted = allocations_in([&] {
+            for(int i = 0; i < kCalls; i++)
+                log_formatted(logger, LogLevel::Info, "student {} ({}) scored {:.1}, rank {}, flags {:x}",
+                              student, "Year 2 Computer Science Department", 87.5, i, 0xbeefu);
+        });
+        const std::size_t old_literal = allocations_in([&] {
+            for(int i = 0; i < kCalls; i++)
+                old_log(logger, "a log message longer than fifteen characters");   // a std::string per call
+        });
+        logger.flush();
+        std::cout << "allocations, " << kCalls << " formatted calls:          " << formatted << '\n';     // 0
+        std::cout << "allocations, " << kCalls << " log(const std::string&): " << old_literal << '\n';   // 10000
+        if(formatted != 0)
+            g_failures++;
+    }
+
+
+    // ------------------------------------------------------------
+    // Benchmark: caller time per call, against the one-value overloads
+    // (bursts that fit in the logger's ring: the caller never waits for the drain thread;
+    //  the best of 200 rounds: on a busy core a burst can be preempted, by the drain thread among others)
+    // ------------------------------------------------------------
+    constexpr int kRounds = 200;
+    constexpr int kBurst = 1000;
+    double old_three_ms = 1e9, formatted_ms = 1e9, old_string_ms = 1e9, formatted_string_ms = 1e9;
+    AsyncLogger logger(dev_null);
+    logger.log("warm-up", 0);
+    for(int round = 0; round < kRounds; round++) {
+        // three values: three records with the overloads, one line formatted
+        old_three_ms = std::min(old_three_ms, time_ms([&] {
+            for(int i = 0; i < kBurst; i++) {
+                old_log(logger, i);
+                old_log(logger, i * 2);
+                old_log(logger, i * 3);
+            }
+        }));
+        formatted_ms = std::min(formatted_ms, time_ms([&] {
+            for(int i = 0; i < kBurst; i++)
+                log_formatted(logger, LogLevel::Info, "{} {} {}", i, i * 2, i * 3);
+        }));
+
+        // a message: const std::string& built from a literal vs the literal formatted in place
+        old_string_ms = std::min(old_string_ms, time_ms([&] {
+            for(int i = 0; i < kBurst; i++)
+                old_log(logger, "connection accepted from the load balancer");
+        }));
+        formatted_string_ms = std::min(formatted_string_ms, time_ms([&] {
+            for(int i = 0; i < kBurst; i++)
+                log_formatted(logger, LogLevel::Info, "connection accepted from the load balancer");
+        }));
+        logger.flush();
+    }
+    const double calls = kBurst;
+    std::cout << "three ints, 3 x log(int):        " << old_three_ms * 1e6 / calls << " ns\n";
+    std::cout << "three ints, \"{} {} {}\":          " << formatted_ms * 1e6 / calls << " ns\n";
+    std::cout << "message, log(const std::string&): " << old_string_ms * 1e6 / calls << " ns\n";
+    std::cout << "message, formatted:               " << formatted_string_ms * 1e6 / calls << " ns\n";
+
+    const double disabled_ms = time_ms([&] {
+        for(int i = 0; i < 100'000'000; i++)
+            LOG_DEBUG("{} {} {}", i, i * 2, i * 3);
+    });
+    std::cout << "LOG_DEBUG (compiled out):         " << disabled_ms * 1e6 / 1e8 << " ns\n";
+
+    ::close(dev_null);
+    return g_failures == 0 ? 0 : 1;
+}
+
+// Measured (g++ 12 -O2, best of 200 bursts of 1000 calls, output to /dev/null):
+//   allocations per call:   formatted 0       log(const std::string&) with a 44-char literal: 1
+//   three ints in one line:   3 x log(int) ~115 ns     "{} {} {}" ~55 ns    (one record instead of three)
+//   a 44-char message:        log(const std::string&) ~64 ns (malloc + free)     formatted ~52 ns
+//   LOG_DEBUG below LOG_MIN_LEVEL: no code at all (the loop around it is optimized away)
+//
+// Formatting on the caller costs more per value than storing it raw (a to_chars vs an 8-byte store):
+// the gain is in lines with several values (one record, one timestamp), and in strings that would
+// have been copied into a std::string first.